@@ -0,0 +1,107 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Arena Allocation
+//
+// Scratch memory for one top-level form. Reading a form needs a copy of its
+// text, a table of tokens and the like, none of which outlives the form:
+// the values the reader builds copy what they keep (symbol names are
+// interned, string literals get their own buffers). So that scratch is
+// bump-allocated from an arena and given back in one shot when the form is
+// done, and the arena's chunks are kept for the next form.
+namespace arena {
+
+class Arena {
+      public:
+        // A position in the arena, to rewind to.
+        struct Mark {
+                size_t chunk;
+                size_t used;
+        };
+
+        void* allocate(size_t size, size_t alignment);
+
+        Mark mark() const { return {current, used}; }
+        // Frees everything allocated since `mark` was taken.
+        void rewind(Mark mark)
+        {
+                current = mark.chunk;
+                used = mark.used;
+        }
+
+        // The bytes the arena holds on to, in use or not.
+        size_t capacity() const;
+
+      private:
+        struct Chunk {
+                std::unique_ptr<char[]> memory;
+                size_t size;
+        };
+
+        static constexpr size_t chunk_bytes = 16 * 1024;
+
+        std::vector<Chunk> chunks;
+        size_t current = 0;
+        size_t used = 0;
+};
+
+// The arena that scratch memory comes from.
+Arena& current();
+
+// Frees everything allocated from the arena while it is open. Scopes nest:
+// `interpreter::rep` opens one per top-level form, and `Reader::read` one
+// per read.
+class Scope {
+      public:
+        Scope() : mark{current().mark()} {}
+        ~Scope() { current().rewind(mark); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        Arena::Mark mark;
+};
+
+// Standard allocator over the current arena, for containers that live
+// within a scope. Freeing is a no-op: the scope frees everything at once.
+template <typename T>
+struct Allocator {
+        using value_type = T;
+
+        Allocator() = default;
+        template <typename U>
+        Allocator(const Allocator<U>&)
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+                return static_cast<T*>(
+                    current().allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(T*, size_t) {}
+
+        template <typename U>
+        bool operator==(const Allocator<U>&) const
+        {
+                return true;
+        }
+        template <typename U>
+        bool operator!=(const Allocator<U>&) const
+        {
+                return false;
+        }
+};
+
+// A copy of `text` in the current arena.
+std::string_view copy(std::string_view text);
+
+} // namespace arena
+
+#endif // ARENA_H
@@ -0,0 +1,57 @@
+#ifndef BIGNUM_H
+#define BIGNUM_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bignum {
+
+// Arbitrary-precision signed integer, stored as a sign and a magnitude of
+// little-endian 32-bit limbs with no leading zero limbs.
+class BigInt {
+      public:
+        BigInt() = default;
+        BigInt(int64_t value);
+
+        static std::optional<BigInt> from_string(std::string_view text);
+
+        bool is_zero() const { return limbs.empty(); }
+        bool is_negative() const { return negative; }
+        bool fits_int64() const;
+        int64_t to_int64() const;
+        double to_double() const;
+        std::string to_string() const;
+
+        BigInt operator-() const;
+        friend BigInt operator+(const BigInt& a, const BigInt& b);
+        friend BigInt operator-(const BigInt& a, const BigInt& b);
+        friend BigInt operator*(const BigInt& a, const BigInt& b);
+
+        // Truncating division, rounding toward zero like C++ integers.
+        static void divmod(const BigInt& a, const BigInt& b, BigInt& quotient,
+                           BigInt& remainder);
+
+        friend int compare(const BigInt& a, const BigInt& b);
+
+        using Limbs = std::vector<uint32_t>;
+
+        const Limbs& magnitude() const { return limbs; }
+
+      private:
+        BigInt(bool negative, Limbs limbs);
+
+        bool negative = false;
+        Limbs limbs;
+};
+
+BigInt operator+(const BigInt& a, const BigInt& b);
+BigInt operator-(const BigInt& a, const BigInt& b);
+BigInt operator*(const BigInt& a, const BigInt& b);
+int compare(const BigInt& a, const BigInt& b);
+
+} // namespace bignum
+
+#endif // BIGNUM_H
@@ -0,0 +1,83 @@
+#ifndef BYTES_H
+#define BYTES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "heap.h"
+#include "type.h"
+
+namespace type {
+
+// Immutable backing storage for byte vectors: either bytes stored inline
+// after the header or a read-only memory-mapped file.
+struct ByteBuffer : HeapObject {
+        size_t size_in_bytes() const override { return sizeof(ByteBuffer) + size; }
+
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+};
+
+// Byte Vector
+//
+// A bytes value is a window onto an immutable buffer, so slicing is O(1) and
+// shares the buffer, and decoding reads straight from it without boxing each
+// byte.
+class Bytes {
+      public:
+        Bytes() = default;
+        explicit Bytes(std::string_view bytes);
+
+        // The contents of the file at `path`, memory-mapped read-only.
+        static Bytes map_file(const std::string& path);
+
+        size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+        const uint8_t* data() const
+        {
+                return buffer ? buffer->data + offset : nullptr;
+        }
+
+        uint8_t operator[](size_t index) const { return data()[index]; }
+        uint8_t at(size_t index) const;
+
+        // The bytes in [start, end), sharing this vector's buffer.
+        Bytes slice(size_t start, size_t end) const;
+
+        // Reads an unsigned `width`-byte integer at `index`.
+        uint64_t read_unsigned(size_t index, size_t width,
+                               bool big_endian) const;
+
+        void trace(CellVisitor& visit) const { visit(buffer.get()); }
+
+      private:
+        Ref<ByteBuffer> buffer;
+        size_t offset = 0;
+        size_t length = 0;
+};
+
+struct BytesCell : HeapObject {
+        explicit BytesCell(Bytes bytes) : bytes(std::move(bytes)) {}
+
+        size_t size_in_bytes() const override { return sizeof(BytesCell); }
+        void trace(CellVisitor& visit) const override { bytes.trace(visit); }
+
+        Bytes bytes;
+};
+
+inline const Bytes& LisppObject::bytes() const
+{
+        static const Bytes empty;
+        return is_bytes() ? cell<BytesCell>()->bytes : empty;
+}
+
+inline LisppObject LisppObject::create_bytes(Bytes bytes)
+{
+        return create_heap(Type::Bytes, new BytesCell{std::move(bytes)});
+}
+
+} // namespace type
+
+#endif // BYTES_H
@@ -0,0 +1,27 @@
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include <cstddef>
+
+#include "type.h"
+
+namespace compare {
+
+// Three-way numeric comparison: negative, zero or positive.
+int numbers(const type::LisppObject& a, const type::LisppObject& b);
+
+// Structural equality, as used by `=`. Numbers compare by value across
+// kinds, so (= 2 2.0) holds.
+bool equal(const type::LisppObject& a, const type::LisppObject& b);
+
+// Total order over keys: negative, zero or positive. Numbers order by
+// value, strings and symbols by name and lists lexicographically; values of
+// different kinds order by kind. Throws for values without an order.
+int order(const type::LisppObject& a, const type::LisppObject& b);
+
+// A hash consistent with `equal`: equal values hash alike.
+size_t hash(const type::LisppObject& value);
+
+} // namespace compare
+
+#endif // COMPARE_H
@@ -0,0 +1,55 @@
+#ifndef DECIMAL_H
+#define DECIMAL_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "bignum.h"
+
+namespace decimal {
+
+// How a result that does not fit the target scale is rounded.
+enum class Rounding { half_even, half_up, half_down, down, up, floor, ceiling };
+
+// Parses a rounding mode name: "half-even", "half-up", "half-down", "down",
+// "up", "floor" or "ceiling".
+std::optional<Rounding> rounding_from_string(std::string_view name);
+
+// An exact decimal number: `unscaled` * 10^-`scale`. This is the general
+// representation; values whose unscaled part fits in 64 bits are stored as
+// immediates and only converted to it on the slow path.
+struct Decimal {
+        bignum::BigInt unscaled;
+        uint32_t scale = 0;
+};
+
+// Parses plain decimal notation, e.g. "-12.340".
+std::optional<Decimal> from_string(std::string_view text);
+std::string to_string(const Decimal& value);
+double to_double(const Decimal& value);
+
+Decimal add(const Decimal& a, const Decimal& b);
+Decimal sub(const Decimal& a, const Decimal& b);
+Decimal mul(const Decimal& a, const Decimal& b);
+// a / b at `scale` digits after the point. Throws on division by zero.
+Decimal div(const Decimal& a, const Decimal& b, uint32_t scale,
+            Rounding mode);
+// `value` at `scale` digits after the point.
+Decimal rescale(const Decimal& value, uint32_t scale, Rounding mode);
+
+int compare(const Decimal& a, const Decimal& b);
+
+// Whether a truncated quotient rounds away from zero under `mode`, given
+// the sign of the exact quotient, how twice the remainder compares to the
+// divisor (`half`) and whether the truncated quotient is odd.
+bool round_away(Rounding mode, bool negative, int half, bool odd);
+
+// Rounds the quotient `n` / `d` to an integer; `d` must not be zero.
+bignum::BigInt round_quotient(const bignum::BigInt& n, const bignum::BigInt& d,
+                              Rounding mode);
+
+} // namespace decimal
+
+#endif // DECIMAL_H
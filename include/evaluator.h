@@ -11,7 +11,7 @@ namespace evaluator {
 
 type::LisppObject eval(const type::LisppObject& ast, Frame& frame);
 type::LisppObject apply(const type::LisppObject& procedure,
-                        const std::vector<type::LisppObject>& arguments);
+                        type::Arguments arguments);
 
 } // namespace evaluator
 
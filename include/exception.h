@@ -42,6 +42,15 @@ class invalid_arg_size : public std::runtime_error {
         }
 };
 
+class heap_quota_error : public std::runtime_error {
+      public:
+        heap_quota_error(size_t quota)
+            : std::runtime_error("\n;Heap quota of " + std::to_string(quota) +
+                                 " bytes exceeded.\n")
+        {
+        }
+};
+
 } // namespace exception
 
 #endif // EXCEPTION_H
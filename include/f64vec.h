@@ -0,0 +1,97 @@
+#ifndef F64VEC_H
+#define F64VEC_H
+
+#include <cstddef>
+
+#include "heap.h"
+#include "type.h"
+
+namespace type {
+
+// Raw doubles stored inline after the header, in one allocation.
+struct F64Buffer : HeapObject {
+        static F64Buffer* create(size_t size);
+        static void operator delete(void* memory) { deallocate_cell(memory); }
+
+        double* values() { return reinterpret_cast<double*>(this + 1); }
+        const double* values() const
+        {
+                return reinterpret_cast<const double*>(this + 1);
+        }
+
+        size_t size_in_bytes() const override
+        {
+                return sizeof(F64Buffer) + size * sizeof(double);
+        }
+
+        size_t size = 0;
+};
+
+// Unboxed Vector
+//
+// An f64vec is a window onto a contiguous buffer of doubles: eight bytes per
+// element rather than a 16-byte tagged value, in a layout numeric loops can
+// vectorize. Slices share the buffer; writes copy it first unless it is owned
+// exclusively.
+class F64Vec {
+      public:
+        F64Vec() = default;
+        // A zero-filled vector of `size` elements.
+        explicit F64Vec(size_t size);
+
+        size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+
+        const double* data() const
+        {
+                return buffer ? buffer->values() + offset : nullptr;
+        }
+        // The elements for writing, unsharing the buffer first.
+        double* mutable_data();
+
+        double operator[](size_t index) const { return data()[index]; }
+        double at(size_t index) const;
+        void set(size_t index, double value);
+
+        // The elements in [start, end), sharing this vector's buffer.
+        F64Vec slice(size_t start, size_t end) const;
+
+        void trace(CellVisitor& visit) const { visit(buffer.get()); }
+
+      private:
+        Ref<F64Buffer> buffer;
+        size_t offset = 0;
+        size_t length = 0;
+};
+
+struct F64VecCell : HeapObject {
+        explicit F64VecCell(F64Vec vec) : vec(std::move(vec)) {}
+
+        size_t size_in_bytes() const override { return sizeof(F64VecCell); }
+        void trace(CellVisitor& visit) const override { vec.trace(visit); }
+
+        F64Vec vec;
+};
+
+inline const F64Vec& LisppObject::f64vec() const
+{
+        static const F64Vec empty;
+        return is_f64vec() ? cell<F64VecCell>()->vec : empty;
+}
+
+inline F64Vec* LisppObject::unique_f64vec()
+{
+        if (!is_f64vec() || data.heap->refcount != 1) {
+                return nullptr;
+        }
+        return &static_cast<F64VecCell*>(data.heap)->vec;
+}
+
+inline LisppObject LisppObject::create_f64vec(F64Vec vec)
+{
+        return create_heap(Type::F64Vec, new F64VecCell{std::move(vec)});
+}
+
+} // namespace type
+
+#endif // F64VEC_H
@@ -0,0 +1,32 @@
+#ifndef FOOTPRINT_H
+#define FOOTPRINT_H
+
+#include <cstddef>
+#include <unordered_set>
+
+#include "heap.h"
+#include "type.h"
+
+// Memory Footprint
+//
+// Walks values' heap cells to report how much memory they hold. Cells that
+// several values share are counted once per walk.
+namespace footprint {
+
+using Seen = std::unordered_set<const type::HeapObject*>;
+
+// Bytes of the cells reachable from `value` that are not yet in `seen`,
+// adding them to it. Threading one set through several calls counts shared
+// cells once across all of them.
+size_t reachable_size(const type::LisppObject& value, Seen& seen);
+
+// The value itself plus every cell reachable from it.
+size_t deep_size(const type::LisppObject& value);
+
+// Bytes that dropping this one reference to `value` would free: the cells
+// reachable from it that nothing outside its own graph refers to.
+size_t retained_size(const type::LisppObject& value);
+
+} // namespace footprint
+
+#endif // FOOTPRINT_H
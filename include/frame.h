@@ -6,27 +6,83 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "exception.h"
+#include "heap.h"
 #include "operators.h"
+#include "small_vector.h"
+#include "symbols.h"
 #include "type.h"
 
-class Frame {
+// Frames are heap cells, so closures can own the frame they close over.
+// A frame constructed directly (the global frame, or one on the C++ stack)
+// is pinned: its owner outlives everything that refers to it. Frames made by
+// `create` are owned by their references, and as they are the one kind of
+// cell that is filled in after it is referenced, they are what the cycle
+// collector watches.
+//
+// A call or `let` frame links to its parent and holds a handful of
+// bindings inline, so making one costs a single pooled cell. Frames that
+// grow large (the global frame) also index their bindings by symbol.
+class Frame : public type::HeapObject {
       public:
-        Frame() = default;
-        Frame(std::shared_ptr<Frame> parent) : parent(std::move(parent)) {}
+        Frame() { pin(); }
+        explicit Frame(type::Ref<Frame> parent) : parent(std::move(parent))
+        {
+                pin();
+        }
+        Frame(const Frame& other);
 
-        type::LisppObject lookup(const std::string& sym) const;
-        void set(const std::string& sym, const type::LisppObject& value);
-        void print_symbols() const;
+        // A new heap frame below `parent`.
+        static type::Ref<Frame> create(type::Ref<Frame> parent = {});
+
+        type::LisppObject lookup(symbols::SymbolId sym) const;
+        void set(symbols::SymbolId sym, const type::LisppObject& value);
+        // Lists this frame's symbols; with `sizes`, each with the bytes its
+        // binding alone keeps alive, largest first.
+        void print_symbols(bool sizes = false) const;
+
+        // Bytes held by this frame and its parents: their tables and every
+        // bound value, counting values shared between bindings once.
+        size_t memory() const;
 
         static Frame global();
 
+        size_t size_in_bytes() const override;
+        void trace(type::CellVisitor& visit) const override;
+        void drop_references() override;
+
       private:
-        std::optional<Frame> find(const std::string& sym) const;
+        struct Binding {
+                symbols::SymbolId symbol;
+                type::LisppObject value;
+        };
+
+        using Index = std::unordered_map<symbols::SymbolId, uint32_t>;
+
+        static constexpr size_t inline_bindings = 4;
+        // Past this many bindings, lookups go through the index.
+        static constexpr size_t index_threshold = 8;
+
+        // The binding of `sym` in this frame alone.
+        const type::LisppObject* find(symbols::SymbolId sym) const;
+        type::LisppObject* find(symbols::SymbolId sym)
+        {
+                return const_cast<type::LisppObject*>(
+                    std::as_const(*this).find(sym));
+        }
+
+        void pin()
+        {
+                refcount = 1;
+                pinned = true;
+                cyclic = false;
+        }
 
-        std::shared_ptr<Frame> parent;
-        std::unordered_map<std::string, type::LisppObject> symbols;
+        type::Ref<Frame> parent;
+        type::SmallVector<Binding, inline_bindings> bindings;
+        std::unique_ptr<Index> index;
 };
 
 #endif // FRAME_H
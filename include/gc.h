@@ -0,0 +1,75 @@
+#ifndef GC_H
+#define GC_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "heap.h"
+#include "type.h"
+
+// Cycle Collection
+//
+// Reference counting frees a cell as soon as its last reference goes, but
+// not a group of cells that refer to one another: a closure bound in the
+// frame it closes over, or a transient added to itself. Such cycles can only
+// be closed through a cell that is changed after it is referenced, so only
+// those (frames and transients) are watched. Whenever one of them loses a
+// reference and survives, it is buffered as a candidate. A collection traces
+// the cells reachable from the candidates and counts the references each
+// receives from within that graph. A cell with more references than that is
+// held from outside (by a binding, a pinned frame or a value on the C++
+// stack), and so is everything it reaches; the rest is garbage, and emptying
+// its cyclic cells frees it all.
+//
+// A collection runs in slices of at most `LISPP_GC_PAUSE_US` microseconds
+// (1000 by default), interleaved with evaluation. The collector holds a
+// reference to every cell it has reached, so none is freed or edited in
+// place under it. A cell it has reached that drops a reference to another
+// (a frame rebinding a name, a transient being edited) must shade the old
+// referent first: the count taken for it no longer holds, so it is kept.
+namespace gc {
+
+// Slice pauses by power-of-two bucket: bucket i counts pauses under 2^i
+// microseconds, and the last bucket the rest.
+using PauseHistogram = std::array<uint64_t, 18>;
+
+struct Stats {
+        uint64_t collections = 0;
+        uint64_t slices = 0;
+        uint64_t reclaimed_cells = 0;
+        uint64_t last_pause_us = 0;
+        uint64_t max_pause_us = 0;
+        uint64_t total_pause_us = 0;
+        size_t candidates = 0;
+        PauseHistogram pauses{};
+};
+
+// Finishes the collection in progress, then collects the buffered
+// candidates in one go. Returns the number of cells reclaimed.
+size_t collect();
+
+// Runs a slice of the collection in progress, or starts one once enough
+// candidates are buffered. Called at points where every live cell is held
+// by a counted reference.
+void maybe_collect();
+
+// Starts a collection over the buffered candidates, if none is in progress.
+void start();
+
+// Runs the collection in progress for up to `budget_us` microseconds, doing
+// at least one unit of work. Returns whether it has finished.
+bool step(uint64_t budget_us);
+
+// Write barrier: called before a cell that may be part of the collection in
+// progress drops its reference to `value`.
+void shade(const type::LisppObject& value);
+// Write barrier for a cell about to be edited in ways too varied to track:
+// every cell it references now is shaded.
+void shade_references(const type::HeapObject& cell);
+
+const Stats& stats();
+
+} // namespace gc
+
+#endif // GC_H
@@ -0,0 +1,315 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <malloc.h>
+#include <new>
+#include <utility>
+
+#include "exception.h"
+
+namespace type {
+struct HeapObject;
+}
+
+// The cycle collector's candidate buffer; see gc.h.
+namespace gc {
+void buffer(type::HeapObject* cell);
+void unbuffer(type::HeapObject* cell);
+} // namespace gc
+
+// The allocation profiler's sampler; see profiler.h. Each allocation counts
+// down the bytes until the next sample, which `sample` takes.
+namespace profiler {
+inline int64_t bytes_until_sample = std::numeric_limits<int64_t>::max();
+void sample(size_t size);
+} // namespace profiler
+
+namespace type {
+
+// Heap Payloads
+//
+// Anything that does not fit in a machine word lives in a reference-counted
+// heap cell. Copying a `LisppObject` only bumps the count of its cell.
+
+// Memory currently held by heap cells, and its high-water mark.
+struct HeapUsage {
+        size_t bytes = 0;
+        size_t peak_bytes = 0;
+        size_t cells = 0;
+};
+
+inline HeapUsage heap_usage;
+
+// The live bytes past which allocating a cell fails, and the quota that
+// limit came from; see `HeapQuota`.
+struct HeapLimit {
+        size_t bytes = std::numeric_limits<size_t>::max();
+        size_t quota = std::numeric_limits<size_t>::max();
+};
+
+inline HeapLimit heap_limit;
+
+// Throws rather than let a cell of `size` bytes take the heap past its
+// limit. Called before anything is allocated, so a failed allocation
+// leaves nothing to undo.
+inline void check_quota(size_t size)
+{
+        if (heap_usage.bytes + size > heap_limit.bytes) {
+                throw exception::heap_quota_error(heap_limit.quota);
+        }
+}
+
+inline void note_allocation(size_t size)
+{
+        heap_usage.bytes += size;
+        heap_usage.cells++;
+        if (heap_usage.bytes > heap_usage.peak_bytes) {
+                heap_usage.peak_bytes = heap_usage.bytes;
+        }
+        profiler::bytes_until_sample -= static_cast<int64_t>(size);
+        if (profiler::bytes_until_sample < 0) {
+                profiler::sample(size);
+        }
+}
+
+inline void note_deallocation(size_t size)
+{
+        heap_usage.bytes -= size;
+        heap_usage.cells--;
+}
+
+// Cells too large for the pools, and cells whose contents are stored inline
+// after them, are allocated through these. Sizes are what the allocator
+// actually reserved.
+inline void* allocate_cell(size_t size)
+{
+        check_quota(size);
+        void* memory = std::malloc(size);
+        if (memory == nullptr) {
+                throw std::bad_alloc();
+        }
+        note_allocation(malloc_usable_size(memory));
+        return memory;
+}
+
+inline void deallocate_cell(void* memory)
+{
+        if (memory != nullptr) {
+                note_deallocation(malloc_usable_size(memory));
+                std::free(memory);
+        }
+}
+
+// Small cells are carved out of large chunks by bumping a pointer, and
+// freed ones go onto a free list for their size class, to be reused before
+// the chunk is touched again. Most cells die young, so allocating is a
+// free-list pop or a pointer increment and freeing is a push. Chunks are
+// kept for the life of the process.
+class CellPools {
+      public:
+        static constexpr size_t granule = 16;
+        static constexpr size_t max_size = 256;
+
+        static void* allocate(size_t size)
+        {
+                size_t rounded = round(size);
+                check_quota(rounded);
+                note_allocation(rounded);
+                Block*& free_list = free_lists[rounded / granule - 1];
+                if (free_list != nullptr) {
+                        Block* block = free_list;
+                        free_list = block->next;
+                        return block;
+                }
+                if (chunk_end - next_byte < static_cast<ptrdiff_t>(rounded)) {
+                        next_byte = static_cast<char*>(
+                            ::operator new(chunk_bytes, granule_alignment));
+                        chunk_end = next_byte + chunk_bytes;
+                }
+                void* memory = next_byte;
+                next_byte += rounded;
+                return memory;
+        }
+
+        static void deallocate(void* memory, size_t size)
+        {
+                size_t rounded = round(size);
+                note_deallocation(rounded);
+                Block*& free_list = free_lists[rounded / granule - 1];
+                auto* block = static_cast<Block*>(memory);
+                block->next = free_list;
+                free_list = block;
+        }
+
+      private:
+        struct Block {
+                Block* next;
+        };
+
+        static constexpr size_t chunk_bytes = 64 * 1024;
+        static constexpr std::align_val_t granule_alignment{granule};
+
+        static size_t round(size_t size)
+        {
+                return (size + granule - 1) & ~(granule - 1);
+        }
+
+        static inline Block* free_lists[max_size / granule] = {};
+        static inline char* next_byte = nullptr;
+        static inline char* chunk_end = nullptr;
+};
+
+// Caps the heap bytes an evaluation may hold while the quota is open, over
+// and above those live when it opened, and measures the most it held at
+// once. Cells freed along the way make room for new ones. Quotas nest, and
+// an inner one cannot loosen an outer one. `peak` is written when the quota
+// closes, however the evaluation ended.
+class HeapQuota {
+      public:
+        HeapQuota(size_t quota, size_t& peak)
+            : peak{peak}, base{heap_usage.bytes}, saved_limit{heap_limit},
+              saved_peak{heap_usage.peak_bytes}
+        {
+                size_t room = heap_limit.bytes - std::min(heap_limit.bytes, base);
+                if (quota < room) {
+                        heap_limit = HeapLimit{base + quota, quota};
+                }
+                heap_usage.peak_bytes = base;
+        }
+        ~HeapQuota()
+        {
+                peak = heap_usage.peak_bytes - base;
+                heap_limit = saved_limit;
+                heap_usage.peak_bytes =
+                    std::max(saved_peak, heap_usage.peak_bytes);
+        }
+
+        HeapQuota(const HeapQuota&) = delete;
+        HeapQuota& operator=(const HeapQuota&) = delete;
+
+      private:
+        size_t& peak;
+        size_t base;
+        HeapLimit saved_limit;
+        size_t saved_peak;
+};
+
+// Receives the cells that another cell references, for walks over the heap.
+// Empty references arrive as null and are skipped.
+struct CellVisitor {
+        virtual ~CellVisitor() = default;
+        virtual void operator()(const HeapObject* cell) = 0;
+};
+
+struct HeapObject {
+        HeapObject() = default;
+        // A copied cell starts out unreferenced, like any new cell.
+        HeapObject(const HeapObject& other) : cyclic{other.cyclic} {}
+        HeapObject& operator=(const HeapObject&) { return *this; }
+
+        static void* operator new(size_t size)
+        {
+                return size <= CellPools::max_size ? CellPools::allocate(size)
+                                                   : allocate_cell(size);
+        }
+        static void operator delete(void* memory, size_t size)
+        {
+                if (size <= CellPools::max_size) {
+                        CellPools::deallocate(memory, size);
+                }
+                else {
+                        deallocate_cell(memory);
+                }
+        }
+
+        uint32_t refcount = 0;
+        // Set on cells whose contents can change after construction (frames
+        // and transients); every reference cycle runs through one of them,
+        // so only they are candidates for the cycle collector.
+        bool cyclic = false;
+        // Set on cells held from outside the heap, such as a frame that lives
+        // on the stack: they are always live.
+        bool pinned = false;
+        // Whether the cell is in the cycle collector's candidate buffer.
+        bool buffered = false;
+        // Whether the cell is part of the collection in progress.
+        bool traced = false;
+
+        virtual ~HeapObject()
+        {
+                if (buffered) {
+                        gc::unbuffer(this);
+                }
+        }
+
+        // The memory this cell occupies, counting storage it owns outright
+        // (inline elements, vectors) but not the cells it references.
+        virtual size_t size_in_bytes() const { return sizeof(HeapObject); }
+
+        // Passes each cell this one references to `visit`, once per
+        // reference, so a walk can account for every refcount.
+        virtual void trace(CellVisitor& visit) const {}
+
+        // Drops every reference this cell holds, to break a garbage cycle.
+        // Only cyclic cells need to: clearing those frees the rest.
+        virtual void drop_references() {}
+};
+
+inline void retain(HeapObject* heap)
+{
+        if (heap != nullptr) {
+                ++heap->refcount;
+        }
+}
+
+// A cyclic cell that survives a decrement may now be held only by a cycle,
+// so it becomes a candidate for the next cycle collection.
+inline void release(HeapObject* heap)
+{
+        if (heap == nullptr) {
+                return;
+        }
+        if (--heap->refcount == 0) {
+                delete heap;
+        }
+        else if (heap->cyclic && !heap->buffered) {
+                gc::buffer(heap);
+        }
+}
+
+// Owning pointer to a heap cell, for payloads that reference other cells.
+template <typename T>
+class Ref {
+      public:
+        Ref() = default;
+        explicit Ref(T* heap) : heap{heap} { retain(heap); }
+        Ref(const Ref& other) : heap{other.heap} { retain(heap); }
+        Ref(Ref&& other) noexcept : heap{other.heap} { other.heap = nullptr; }
+        Ref& operator=(Ref other) noexcept
+        {
+                std::swap(heap, other.heap);
+                return *this;
+        }
+        ~Ref() { release(heap); }
+
+        T* get() const { return heap; }
+        T* operator->() const { return heap; }
+        T& operator*() const { return *heap; }
+        explicit operator bool() const { return heap != nullptr; }
+
+        // Whether this is the only reference, so the cell may be mutated
+        // in place without being observed elsewhere.
+        bool unique() const { return heap != nullptr && heap->refcount == 1; }
+
+      private:
+        T* heap = nullptr;
+};
+
+} // namespace type
+
+#endif // HEAP_H
@@ -5,13 +5,26 @@
 #include "exception.h"
 #include "frame.h"
 #include "printer.h"
+#include "profiler.h"
 #include "reader.h"
 #include <iostream>
+#include <limits>
 
 namespace interpreter {
 
+// What one evaluation may allocate, and what it did.
+struct Budget {
+        // Heap bytes it may hold beyond those live when it starts; past
+        // them, allocating throws `exception::heap_quota_error`.
+        size_t heap_bytes = std::numeric_limits<size_t>::max();
+        // The most heap bytes it held at once, set when it returns or
+        // throws.
+        size_t peak_heap_bytes = 0;
+};
+
 std::string getinput();
 std::string rep(const std::string& line, Frame& frame);
+std::string rep(const std::string& line, Frame& frame, Budget& budget);
 void repl();
 
 } // namespace interpreter
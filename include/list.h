@@ -0,0 +1,247 @@
+#ifndef LIST_H
+#define LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "heap.h"
+#include "type.h"
+
+namespace type {
+
+// A leaf of the persistent vector: up to `List::width` values stored inline
+// after the header.
+struct VectorLeaf : HeapObject {
+        static VectorLeaf* create(uint32_t capacity);
+        ~VectorLeaf() override;
+        static void operator delete(void* memory) { deallocate_cell(memory); }
+
+        size_t size_in_bytes() const override
+        {
+                return sizeof(VectorLeaf) + capacity * sizeof(LisppObject);
+        }
+
+        void trace(CellVisitor& visit) const override
+        {
+                for (uint32_t i = 0; i < count; i++) {
+                        values()[i].trace(visit);
+                }
+        }
+
+        LisppObject* values() { return reinterpret_cast<LisppObject*>(this + 1); }
+        const LisppObject* values() const
+        {
+                return reinterpret_cast<const LisppObject*>(this + 1);
+        }
+
+        uint32_t count = 0;
+        uint32_t capacity = 0;
+};
+
+// An interior node of the persistent vector; children are branches or, on the
+// last level, leaves.
+struct VectorBranch;
+
+// Persistent Vector
+//
+// Lists are 32-way tries of leaves plus a separate tail leaf, after Clojure's
+// PersistentVector: indexing is O(log32 n), appending copies at most one path
+// and every copy shares structure. `offset` makes `rest` an O(1) view.
+class List {
+      public:
+        static constexpr unsigned bits = 5;
+        static constexpr uint32_t width = 1u << bits;
+        static constexpr uint32_t mask = width - 1;
+
+        class iterator;
+
+        List() = default;
+        List(const LisppObject* items, size_t size);
+        explicit List(const std::vector<LisppObject>& items)
+            : List{items.data(), items.size()}
+        {
+        }
+
+        size_t size() const { return count - offset; }
+        bool empty() const { return size() == 0; }
+
+        const LisppObject& operator[](size_t index) const;
+        const LisppObject& at(size_t index) const;
+        const LisppObject& front() const { return (*this)[0]; }
+
+        iterator begin() const;
+        iterator end() const;
+
+        // All elements but the first, sharing this list's storage.
+        List rest() const;
+        // A new list with `value` appended; this list is unchanged.
+        List conj(LisppObject value) const;
+        // Appends in place, mutating only nodes this list owns exclusively.
+        void push_back(LisppObject value);
+
+        void trace(CellVisitor& visit) const
+        {
+                visit(root.get());
+                visit(tail.get());
+        }
+
+      private:
+        size_t tail_offset() const
+        {
+                return count < width ? 0 : ((count - 1) >> bits) << bits;
+        }
+
+        const VectorLeaf* leaf_for(size_t index) const;
+        void push_tail(unsigned level, Ref<HeapObject>& slot);
+
+        size_t count = 0;
+        size_t offset = 0;
+        unsigned shift = bits;
+        Ref<HeapObject> root;
+        Ref<VectorLeaf> tail;
+};
+
+class List::iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = LisppObject;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const LisppObject*;
+        using reference = const LisppObject&;
+
+        iterator(const List* list, size_t index) : list{list}, index{index}
+        {
+                seek();
+        }
+
+        reference operator*() const { return *current; }
+        pointer operator->() const { return current; }
+
+        iterator& operator++()
+        {
+                ++index;
+                if (++current == leaf_end) {
+                        seek();
+                }
+                return *this;
+        }
+
+        iterator operator++(int)
+        {
+                iterator copy{*this};
+                ++*this;
+                return copy;
+        }
+
+        iterator operator+(size_t n) const { return iterator{list, index + n}; }
+
+        bool operator==(const iterator& other) const
+        {
+                return index == other.index;
+        }
+        bool operator!=(const iterator& other) const
+        {
+                return index != other.index;
+        }
+
+      private:
+        void seek()
+        {
+                if (index < list->count) {
+                        const VectorLeaf* leaf = list->leaf_for(index);
+                        current = leaf->values() + (index & mask);
+                        leaf_end = leaf->values() + leaf->count;
+                }
+                else {
+                        current = leaf_end = nullptr;
+                }
+        }
+
+        const List* list;
+        size_t index;
+        const LisppObject* current = nullptr;
+        const LisppObject* leaf_end = nullptr;
+};
+
+inline const LisppObject& List::operator[](size_t index) const
+{
+        index += offset;
+        return leaf_for(index)->values()[index & mask];
+}
+
+inline List::iterator List::begin() const { return iterator{this, offset}; }
+
+inline List::iterator List::end() const { return iterator{this, count}; }
+
+struct ListCell : HeapObject {
+        explicit ListCell(List items) : items(std::move(items)) {}
+
+        size_t size_in_bytes() const override { return sizeof(ListCell); }
+        void trace(CellVisitor& visit) const override { items.trace(visit); }
+
+        List items;
+};
+
+inline const List& LisppObject::items() const
+{
+        static const List empty;
+        return is_list() ? cell<ListCell>()->items : empty;
+}
+
+inline LisppObject LisppObject::create_list(const std::vector<LisppObject>& list)
+{
+        return create_list(List{list});
+}
+
+inline LisppObject LisppObject::create_list(List list)
+{
+        return create_heap(Type::List, new ListCell{std::move(list)});
+}
+
+// Cons Cells
+//
+// A pair is a classic Lisp cons cell: `cons`, `first` and `rest` are O(1) and
+// never copy.
+
+struct PairCell : HeapObject {
+        PairCell(LisppObject car, LisppObject cdr)
+            : car(std::move(car)), cdr(std::move(cdr))
+        {
+        }
+        ~PairCell() override;
+
+        size_t size_in_bytes() const override { return sizeof(PairCell); }
+
+        void trace(CellVisitor& visit) const override
+        {
+                car.trace(visit);
+                cdr.trace(visit);
+        }
+
+        LisppObject car;
+        LisppObject cdr;
+};
+
+inline const LisppObject& LisppObject::car() const
+{
+        static const LisppObject nil;
+        return is_pair() ? cell<PairCell>()->car : nil;
+}
+
+inline const LisppObject& LisppObject::cdr() const
+{
+        static const LisppObject nil;
+        return is_pair() ? cell<PairCell>()->cdr : nil;
+}
+
+inline LisppObject LisppObject::create_pair(LisppObject car, LisppObject cdr)
+{
+        return create_heap(Type::Pair,
+                           new PairCell{std::move(car), std::move(cdr)});
+}
+
+} // namespace type
+
+#endif // LIST_H
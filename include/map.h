@@ -0,0 +1,122 @@
+#ifndef MAP_H
+#define MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "heap.h"
+#include "type.h"
+
+namespace type {
+
+struct MapNode;
+
+// A slot of a map node: either a key/value entry or a child node.
+struct MapEntry {
+        size_t hash = 0;
+        LisppObject key;
+        LisppObject value;
+        Ref<MapNode> child;
+};
+
+// A node of the hash array mapped trie. `bitmap` marks which of the 32 hash
+// fragments at this level are occupied; `entries` holds them compactly, in
+// fragment order. Keys whose whole hash collides share a collision node,
+// which is scanned linearly.
+struct MapNode : HeapObject {
+        size_t size_in_bytes() const override
+        {
+                return sizeof(MapNode) + entries.capacity() * sizeof(MapEntry);
+        }
+
+        void trace(CellVisitor& visit) const override
+        {
+                for (const auto& entry : entries) {
+                        entry.key.trace(visit);
+                        entry.value.trace(visit);
+                        visit(entry.child.get());
+                }
+        }
+
+        uint32_t bitmap = 0;
+        bool collision = false;
+        std::vector<MapEntry> entries;
+};
+
+// Hash Array Mapped Trie
+//
+// Maps are persistent HAMTs (after Bagwell and Clojure's PersistentHashMap):
+// lookups, `assoc` and `dissoc` are O(log32 n), and updates copy only the
+// nodes on the path to the changed key.
+class Map {
+      public:
+        static constexpr unsigned bits = 5;
+        static constexpr uint32_t mask = (1u << bits) - 1;
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        // The value bound to `key`, or nullptr.
+        const LisppObject* find(const LisppObject& key) const;
+
+        // New maps with `key` bound or removed; this map is unchanged.
+        Map assoc(LisppObject key, LisppObject value) const;
+        Map dissoc(const LisppObject& key) const;
+
+        // In-place updates, mutating only nodes this map owns exclusively.
+        void insert(LisppObject key, LisppObject value);
+        void erase(const LisppObject& key);
+
+        // Calls `visit(key, value)` for every entry, in hash order.
+        template <typename Visit>
+        void for_each(Visit&& visit) const
+        {
+                if (root) {
+                        visit_node(*root, visit);
+                }
+        }
+
+        void trace(CellVisitor& visit) const { visit(root.get()); }
+
+      private:
+        template <typename Visit>
+        static void visit_node(const MapNode& node, Visit& visit)
+        {
+                for (const auto& entry : node.entries) {
+                        if (entry.child) {
+                                visit_node(*entry.child, visit);
+                        }
+                        else {
+                                visit(entry.key, entry.value);
+                        }
+                }
+        }
+
+        size_t count = 0;
+        Ref<MapNode> root;
+};
+
+struct MapCell : HeapObject {
+        explicit MapCell(Map map) : map(std::move(map)) {}
+
+        size_t size_in_bytes() const override { return sizeof(MapCell); }
+        void trace(CellVisitor& visit) const override { map.trace(visit); }
+
+        Map map;
+};
+
+inline const Map& LisppObject::map() const
+{
+        static const Map empty;
+        return is_map() ? cell<MapCell>()->map : empty;
+}
+
+inline LisppObject LisppObject::create_map(Map map)
+{
+        return create_heap(Type::Map, new MapCell{std::move(map)});
+}
+
+} // namespace type
+
+#endif // MAP_H
@@ -2,58 +2,125 @@
 #define OPERATORS_H
 
 #include <cmath>
-#include <functional>
 #include <iostream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "compare.h"
 #include "exception.h"
 #include "printer.h"
+#include "transient.h"
 #include "type.h"
 
 namespace operators {
 
 // Arithmetic
-type::LisppObject add(std::vector<type::LisppObject> args);
-type::LisppObject sub(std::vector<type::LisppObject> args);
-type::LisppObject mul(std::vector<type::LisppObject> args);
-type::LisppObject div(std::vector<type::LisppObject> args);
+type::LisppObject add(type::Arguments args);
+type::LisppObject sub(type::Arguments args);
+type::LisppObject mul(type::Arguments args);
+type::LisppObject div(type::Arguments args);
+
+// Decimals
+type::LisppObject decimal(type::Arguments args);
+type::LisppObject decimal_div(type::Arguments args);
+
+// Introspection
+type::LisppObject sizeof_deep(type::Arguments args);
+type::LisppObject collect(type::Arguments args);
+type::LisppObject gc_stats(type::Arguments args);
+type::LisppObject alloc_profile(type::Arguments args);
 
 // I/O
-type::LisppObject print(std::vector<type::LisppObject> args);
+type::LisppObject print(type::Arguments args);
 
 // List Processing
-type::LisppObject list(std::vector<type::LisppObject> args);
-type::LisppObject is_empty(std::vector<type::LisppObject> args);
-type::LisppObject count(std::vector<type::LisppObject> args);
-type::LisppObject first(std::vector<type::LisppObject> args);
-type::LisppObject rest(std::vector<type::LisppObject> args);
+type::LisppObject list(type::Arguments args);
+type::LisppObject is_empty(type::Arguments args);
+type::LisppObject count(type::Arguments args);
+type::LisppObject first(type::Arguments args);
+type::LisppObject rest(type::Arguments args);
+type::LisppObject cons(type::Arguments args);
+type::LisppObject nth(type::Arguments args);
+type::LisppObject conj(type::Arguments args);
+
+// Strings
+type::LisppObject string_length(type::Arguments args);
+type::LisppObject substring(type::Arguments args);
+type::LisppObject string_append(type::Arguments args);
+type::LisppObject str(type::Arguments args);
+
+// Maps
+type::LisppObject hash_map(type::Arguments args);
+type::LisppObject get(type::Arguments args);
+type::LisppObject assoc(type::Arguments args);
+type::LisppObject dissoc(type::Arguments args);
+type::LisppObject keys(type::Arguments args);
+type::LisppObject vals(type::Arguments args);
+type::LisppObject contains(type::Arguments args);
+type::LisppObject sorted_map(type::Arguments args);
+type::LisppObject subrange(type::Arguments args);
+type::LisppObject first_key(type::Arguments args);
+type::LisppObject last_key(type::Arguments args);
+
+// Transients
+type::LisppObject transient(type::Arguments args);
+type::LisppObject conj_in_place(type::Arguments args);
+type::LisppObject assoc_in_place(type::Arguments args);
+type::LisppObject dissoc_in_place(type::Arguments args);
+type::LisppObject persistent(type::Arguments args);
+
+// Unboxed Vectors
+type::LisppObject f64vec(type::Arguments args);
+type::LisppObject f64vec_get(type::Arguments args);
+type::LisppObject f64vec_set(type::Arguments args);
+type::LisppObject f64vec_slice(type::Arguments args);
+type::LisppObject f64vec_to_list(type::Arguments args);
+
+// Byte Vectors
+type::LisppObject bytes(type::Arguments args);
+type::LisppObject load_bytes(type::Arguments args);
+type::LisppObject bytes_ref(type::Arguments args);
+type::LisppObject bytes_slice(type::Arguments args);
+type::LisppObject read_u16_le(type::Arguments args);
+type::LisppObject read_u16_be(type::Arguments args);
+type::LisppObject read_u32_le(type::Arguments args);
+type::LisppObject read_u32_be(type::Arguments args);
+type::LisppObject read_u64_le(type::Arguments args);
+type::LisppObject read_u64_be(type::Arguments args);
+type::LisppObject read_f64_le(type::Arguments args);
+type::LisppObject read_f64_be(type::Arguments args);
 
 // Logical
 // Note: `_` prefix to avoid C++ keyword clash.
-type::LisppObject _not(std::vector<type::LisppObject> args);
-type::LisppObject _and(std::vector<type::LisppObject> args);
-type::LisppObject _or(std::vector<type::LisppObject> args);
+type::LisppObject _not(type::Arguments args);
+type::LisppObject _and(type::Arguments args);
+type::LisppObject _or(type::Arguments args);
 
 // Relational
-type::LisppObject less(std::vector<type::LisppObject> args);
-type::LisppObject less_eq(std::vector<type::LisppObject> args);
-type::LisppObject greater(std::vector<type::LisppObject> args);
-type::LisppObject greater_eq(std::vector<type::LisppObject> args);
-type::LisppObject equal(std::vector<type::LisppObject> args);
-type::LisppObject not_equal(std::vector<type::LisppObject> args);
+type::LisppObject less(type::Arguments args);
+type::LisppObject less_eq(type::Arguments args);
+type::LisppObject greater(type::Arguments args);
+type::LisppObject greater_eq(type::Arguments args);
+type::LisppObject equal(type::Arguments args);
+type::LisppObject not_equal(type::Arguments args);
 
 // Type Predicates
-type::LisppObject is_list(std::vector<type::LisppObject> args);
-type::LisppObject is_nil(std::vector<type::LisppObject> args);
-type::LisppObject is_true(std::vector<type::LisppObject> args);
-type::LisppObject is_false(std::vector<type::LisppObject> args);
-type::LisppObject is_symbol(std::vector<type::LisppObject> args);
-type::LisppObject is_number(std::vector<type::LisppObject> args);
+type::LisppObject is_list(type::Arguments args);
+type::LisppObject is_pair(type::Arguments args);
+type::LisppObject is_map(type::Arguments args);
+type::LisppObject is_sorted_map(type::Arguments args);
+type::LisppObject is_f64vec(type::Arguments args);
+type::LisppObject is_bytes(type::Arguments args);
+type::LisppObject is_decimal(type::Arguments args);
+type::LisppObject is_string(type::Arguments args);
+type::LisppObject is_nil(type::Arguments args);
+type::LisppObject is_true(type::Arguments args);
+type::LisppObject is_false(type::Arguments args);
+type::LisppObject is_symbol(type::Arguments args);
+type::LisppObject is_number(type::Arguments args);
 
-using CoreOperator =
-    std::function<type::LisppObject(std::vector<type::LisppObject>)>;
+using CoreOperator = type::Builtin;
 
 // Core Operator Table
 static std::unordered_map<std::string, CoreOperator> core = {
@@ -62,6 +129,14 @@ static std::unordered_map<std::string, CoreOperator> core = {
     {"-", &sub},
     {"*", &mul},
     {"/", &div},
+    // Decimals
+    {"decimal", &decimal},
+    {"decimal-div", &decimal_div},
+    // Introspection
+    {"sizeof-deep", &sizeof_deep},
+    {"gc", &collect},
+    {"gc-stats", &gc_stats},
+    {"alloc-profile", &alloc_profile},
     // I/0
     {"print", &print},
     // List Processing
@@ -70,6 +145,54 @@ static std::unordered_map<std::string, CoreOperator> core = {
     {"count", &count},
     {"first", &first},
     {"rest", &rest},
+    {"cons", &cons},
+    {"car", &first},
+    {"cdr", &rest},
+    {"nth", &nth},
+    {"conj", &conj},
+    // Strings
+    {"string-length", &string_length},
+    {"substring", &substring},
+    {"string-append", &string_append},
+    {"str", &str},
+    // Maps
+    {"hash-map", &hash_map},
+    {"get", &get},
+    {"assoc", &assoc},
+    {"dissoc", &dissoc},
+    {"keys", &keys},
+    {"vals", &vals},
+    {"contains?", &contains},
+    {"sorted-map", &sorted_map},
+    {"sorted-get", &get},
+    {"subrange", &subrange},
+    {"first-key", &first_key},
+    {"last-key", &last_key},
+    // Transients
+    {"transient", &transient},
+    {"conj!", &conj_in_place},
+    {"assoc!", &assoc_in_place},
+    {"dissoc!", &dissoc_in_place},
+    {"persistent!", &persistent},
+    // Unboxed Vectors
+    {"f64vec", &f64vec},
+    {"f64vec-get", &f64vec_get},
+    {"f64vec-set", &f64vec_set},
+    {"f64vec-slice", &f64vec_slice},
+    {"f64vec->list", &f64vec_to_list},
+    // Byte Vectors
+    {"bytes", &bytes},
+    {"load-bytes", &load_bytes},
+    {"bytes-ref", &bytes_ref},
+    {"bytes-slice", &bytes_slice},
+    {"read-u16-le", &read_u16_le},
+    {"read-u16-be", &read_u16_be},
+    {"read-u32-le", &read_u32_le},
+    {"read-u32-be", &read_u32_be},
+    {"read-u64-le", &read_u64_le},
+    {"read-u64-be", &read_u64_be},
+    {"read-f64-le", &read_f64_le},
+    {"read-f64-be", &read_f64_be},
     // Logical
     {"not", &_not},
     {"and", &_and},
@@ -83,6 +206,13 @@ static std::unordered_map<std::string, CoreOperator> core = {
     {"!=", &not_equal},
     // Type Predicates
     {"list?", &is_list},
+    {"pair?", &is_pair},
+    {"map?", &is_map},
+    {"sorted-map?", &is_sorted_map},
+    {"f64vec?", &is_f64vec},
+    {"bytes?", &is_bytes},
+    {"decimal?", &is_decimal},
+    {"string?", &is_string},
     {"nil?", &is_nil},
     {"true?", &is_true},
     {"false?", &is_false},
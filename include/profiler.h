@@ -0,0 +1,60 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "heap.h"
+#include "symbols.h"
+
+// Allocation Profiling
+//
+// Attributes heap cell allocations to the Lispp calls that made them. The
+// evaluator keeps a stack of the calls in progress, each named by the
+// symbol it was called through (`fn` for an anonymous function), so a
+// builtin shows up under the function that called it. Rather than record
+// every allocation, the profiler samples one about every `sample_bytes`
+// allocated bytes, at random, and scales each sample up by the chance it
+// had of being taken, so the totals are unbiased estimates.
+//
+// Reports are in folded-stack form, one line per stack: the calls from the
+// outermost in, separated by semicolons, then a space and the weight, as flame
+// graph tools read it. Setting `LISPP_ALLOC_PROFILE`
+// to a path profiles the REPL, sampling every `LISPP_ALLOC_SAMPLE_BYTES`
+// (64 KiB by default), and writes the bytes report there on exit.
+namespace profiler {
+
+constexpr size_t default_sample_bytes = 64 * 1024;
+
+enum class Weight { bytes, count };
+
+// Starts sampling about every `sample_bytes` allocated bytes, discarding
+// earlier samples. Zero stops sampling.
+void start(size_t sample_bytes);
+bool running();
+
+// The samples so far, weighted by estimated bytes or allocations.
+std::string report(Weight weight = Weight::bytes);
+// Writes the bytes report to `path`.
+void write(const std::string& path);
+
+// The calls in progress, outermost first. Kept whether or not the
+// profiler is running, so it can be started anywhere.
+inline std::vector<symbols::SymbolId> calls;
+
+// A call in progress, from the point its arguments are evaluated until it
+// returns.
+class Call {
+      public:
+        explicit Call(symbols::SymbolId name) { calls.push_back(name); }
+        ~Call() { calls.pop_back(); }
+
+        Call(const Call&) = delete;
+        Call& operator=(const Call&) = delete;
+};
+
+} // namespace profiler
+
+#endif // PROFILER_H
@@ -8,20 +8,29 @@
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "arena.h"
 #include "syntax.h"
 #include "type.h"
 
+// The reader's scratch (the program's text, its tokens and the literal
+// table) lives in the current arena, and is gone once `read` returns.
 class Reader {
       public:
-        Reader(const std::vector<std::string>& tokens)
-            : tokens{tokens}, position{0}
+        using Tokens =
+            std::vector<std::string_view, arena::Allocator<std::string_view>>;
+
+        explicit Reader(Tokens tokens) : tokens{std::move(tokens)}, position{0}
         {
         }
 
         static type::LisppObject read(const std::string& program);
-        static std::vector<std::string> tokenize(const std::string& text);
+        // Splits `text` into tokens viewing a copy of it in the current
+        // arena.
+        static Tokens tokenize(std::string_view text);
 
         type::LisppObject read_form();
         type::LisppObject read_list();
@@ -29,11 +38,19 @@ class Reader {
         type::LisppObject read_atom();
 
       private:
-        std::vector<std::string> tokens;
+        Tokens tokens;
         unsigned int position;
-
-        std::optional<std::string> next();
-        std::optional<std::string> peek();
+        // Literals that live in heap cells, keyed by their source text, so
+        // repeated literals in one program share a single cell.
+        std::unordered_map<
+            std::string_view, type::LisppObject, std::hash<std::string_view>,
+            std::equal_to<std::string_view>,
+            arena::Allocator<
+                std::pair<const std::string_view, type::LisppObject>>>
+            constants;
+
+        std::optional<std::string_view> next();
+        std::optional<std::string_view> peek();
         bool out_of_bounds();
 };
 
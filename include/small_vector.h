@@ -0,0 +1,188 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace type {
+
+// Small-Buffer Vector
+//
+// A vector that keeps its first `N` elements inline and only allocates once
+// it grows past them. Call forms, argument lists and freshly read lists are
+// almost always short, so building them usually costs no allocation at all.
+template <typename T, size_t N>
+class SmallVector {
+      public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        SmallVector() = default;
+
+        SmallVector(std::initializer_list<T> items)
+        {
+                reserve(items.size());
+                for (const auto& item : items) {
+                        push_back(item);
+                }
+        }
+
+        SmallVector(const SmallVector& other)
+        {
+                reserve(other.count);
+                for (const auto& item : other) {
+                        push_back(item);
+                }
+        }
+
+        SmallVector(SmallVector&& other) noexcept { take(other); }
+
+        SmallVector& operator=(const SmallVector& other)
+        {
+                if (this != &other) {
+                        SmallVector copy{other};
+                        *this = std::move(copy);
+                }
+                return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& other) noexcept
+        {
+                if (this != &other) {
+                        reset();
+                        take(other);
+                }
+                return *this;
+        }
+
+        ~SmallVector() { reset(); }
+
+        size_t size() const { return count; }
+        size_t capacity() const { return limit; }
+        bool empty() const { return count == 0; }
+
+        T* data() { return items; }
+        const T* data() const { return items; }
+
+        iterator begin() { return items; }
+        iterator end() { return items + count; }
+        const_iterator begin() const { return items; }
+        const_iterator end() const { return items + count; }
+
+        T& operator[](size_t index) { return items[index]; }
+        const T& operator[](size_t index) const { return items[index]; }
+
+        T& at(size_t index)
+        {
+                check(index);
+                return items[index];
+        }
+        const T& at(size_t index) const
+        {
+                check(index);
+                return items[index];
+        }
+
+        T& front() { return items[0]; }
+        const T& front() const { return items[0]; }
+        T& back() { return items[count - 1]; }
+        const T& back() const { return items[count - 1]; }
+
+        void reserve(size_t wanted)
+        {
+                if (wanted <= limit) {
+                        return;
+                }
+                auto* grown = static_cast<T*>(::operator new(wanted * sizeof(T)));
+                for (size_t i = 0; i < count; i++) {
+                        new (&grown[i]) T{std::move(items[i])};
+                        items[i].~T();
+                }
+                if (!is_inline()) {
+                        ::operator delete(items);
+                }
+                items = grown;
+                limit = wanted;
+        }
+
+        void push_back(const T& item) { emplace_back(item); }
+        void push_back(T&& item) { emplace_back(std::move(item)); }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+                if (count == limit) {
+                        // Construct first: `args` may refer into this vector.
+                        T item{std::forward<Args>(args)...};
+                        reserve(limit * 2);
+                        return *new (&items[count++]) T{std::move(item)};
+                }
+                return *new (&items[count++]) T{std::forward<Args>(args)...};
+        }
+
+        void pop_back() { items[--count].~T(); }
+
+        void clear()
+        {
+                while (count > 0) {
+                        pop_back();
+                }
+        }
+
+      private:
+        bool is_inline() const
+        {
+                return items == reinterpret_cast<const T*>(storage);
+        }
+
+        void check(size_t index) const
+        {
+                if (index >= count) {
+                        throw std::out_of_range("SmallVector::at");
+                }
+        }
+
+        // Destroys the elements and frees any heap buffer.
+        void reset()
+        {
+                clear();
+                if (!is_inline()) {
+                        ::operator delete(items);
+                        items = reinterpret_cast<T*>(storage);
+                        limit = N;
+                }
+        }
+
+        // Moves `other`'s contents into this empty, inline vector.
+        void take(SmallVector& other)
+        {
+                if (other.is_inline()) {
+                        for (size_t i = 0; i < other.count; i++) {
+                                new (&items[i]) T{std::move(other.items[i])};
+                        }
+                        count = other.count;
+                        other.clear();
+                }
+                else {
+                        items = other.items;
+                        count = other.count;
+                        limit = other.limit;
+                        other.items = reinterpret_cast<T*>(other.storage);
+                        other.count = 0;
+                        other.limit = N;
+                }
+        }
+
+        alignas(T) unsigned char storage[N * sizeof(T)];
+        T* items = reinterpret_cast<T*>(storage);
+        size_t count = 0;
+        size_t limit = N;
+};
+
+} // namespace type
+
+#endif // SMALL_VECTOR_H
@@ -0,0 +1,127 @@
+#ifndef SORTED_MAP_H
+#define SORTED_MAP_H
+
+#include <cstddef>
+#include <vector>
+
+#include "heap.h"
+#include "type.h"
+
+namespace type {
+
+// A B-tree node. Keys and values are kept in separate contiguous arrays so
+// the binary search within a node touches only the keys; interior nodes
+// have one more child than keys.
+struct SortedNode : HeapObject {
+        bool leaf() const { return children.empty(); }
+
+        size_t size_in_bytes() const override
+        {
+                return sizeof(SortedNode) +
+                       (keys.capacity() + values.capacity()) *
+                           sizeof(LisppObject) +
+                       children.capacity() * sizeof(Ref<SortedNode>);
+        }
+
+        void trace(CellVisitor& visit) const override
+        {
+                for (size_t i = 0; i < keys.size(); i++) {
+                        keys[i].trace(visit);
+                        values[i].trace(visit);
+                }
+                for (const auto& child : children) {
+                        visit(child.get());
+                }
+        }
+
+        std::vector<LisppObject> keys;
+        std::vector<LisppObject> values;
+        std::vector<Ref<SortedNode>> children;
+};
+
+// Sorted Map
+//
+// Sorted maps are persistent B-trees of minimum degree `degree`, ordered by
+// `compare::order`. Wide nodes keep the tree shallow and each node's keys in
+// one cache-friendly array. Lookups and updates are O(log n); updates copy
+// only the nodes they touch and mutate in place where uniquely owned.
+class SortedMap {
+      public:
+        static constexpr size_t degree = 16;
+        static constexpr size_t max_keys = 2 * degree - 1;
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        // The value bound to `key`, or nullptr.
+        const LisppObject* find(const LisppObject& key) const;
+
+        // The smallest and largest keys, or nullptr when empty.
+        const LisppObject* first_key() const;
+        const LisppObject* last_key() const;
+
+        // The entries with `low <= key < high`, as a new sorted map.
+        SortedMap subrange(const LisppObject& low,
+                           const LisppObject& high) const;
+
+        // New maps with `key` bound or removed; this map is unchanged.
+        SortedMap assoc(LisppObject key, LisppObject value) const;
+        SortedMap dissoc(const LisppObject& key) const;
+
+        // In-place updates, mutating only nodes this map owns exclusively.
+        void insert(LisppObject key, LisppObject value);
+        void erase(const LisppObject& key);
+
+        // Calls `visit(key, value)` for every entry, in key order.
+        template <typename Visit>
+        void for_each(Visit&& visit) const
+        {
+                if (root) {
+                        visit_node(*root, visit);
+                }
+        }
+
+        void trace(CellVisitor& visit) const { visit(root.get()); }
+
+      private:
+        template <typename Visit>
+        static void visit_node(const SortedNode& node, Visit& visit)
+        {
+                for (size_t i = 0; i < node.keys.size(); i++) {
+                        if (!node.leaf()) {
+                                visit_node(*node.children[i], visit);
+                        }
+                        visit(node.keys[i], node.values[i]);
+                }
+                if (!node.leaf()) {
+                        visit_node(*node.children.back(), visit);
+                }
+        }
+
+        size_t count = 0;
+        Ref<SortedNode> root;
+};
+
+struct SortedMapCell : HeapObject {
+        explicit SortedMapCell(SortedMap map) : map(std::move(map)) {}
+
+        size_t size_in_bytes() const override { return sizeof(SortedMapCell); }
+        void trace(CellVisitor& visit) const override { map.trace(visit); }
+
+        SortedMap map;
+};
+
+inline const SortedMap& LisppObject::sorted_map() const
+{
+        static const SortedMap empty;
+        return is_sorted_map() ? cell<SortedMapCell>()->map : empty;
+}
+
+inline LisppObject LisppObject::create_sorted_map(SortedMap map)
+{
+        return create_heap(Type::SortedMap, new SortedMapCell{std::move(map)});
+}
+
+} // namespace type
+
+#endif // SORTED_MAP_H
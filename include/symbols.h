@@ -0,0 +1,19 @@
+#ifndef SYMBOLS_H
+#define SYMBOLS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace symbols {
+
+// Interned symbol names are identified by a dense integer id, so comparing
+// or hashing a symbol never touches its characters.
+using SymbolId = uint32_t;
+
+SymbolId intern(std::string_view name);
+const std::string& name(SymbolId id);
+
+} // namespace symbols
+
+#endif // SYMBOLS_H
@@ -6,13 +6,15 @@
 #include <vector>
 
 #include "exception.h"
+#include "symbols.h"
 #include "type.h"
 
 namespace syntax {
 
 // Excuse my poor regex-ing...
 static inline const std::string grammar =
-    "(-?\\d+\\.?\\d*)|(<=|>=|<|>|[-+*/^%~=])|(\"(.)*\")|(\\w+\\?*)|(\\(|\\))";
+    "(-?\\d+\\.?\\d*M?)|(<=|>=|!=|<|>|[-+*/^%~=])|(\"[^\"]*\")|"
+    "(\\w[\\w>-]*[?!]*)|(\\(|\\))";
 
 // Delimiter Syntax Classes
 
@@ -28,17 +30,17 @@ static std::unordered_map<DelimiterKind, char> delimiters = {
     {DelimiterKind::list, '('},
     {DelimiterKind::string, '"'}};
 
-inline bool is_comment_delimited(const std::string& token)
+inline bool is_comment_delimited(std::string_view token)
 {
         return token.at(0) == delimiters[DelimiterKind::comment];
 }
 
-inline bool is_list_delimited(const std::string& token)
+inline bool is_list_delimited(std::string_view token)
 {
         return token.at(0) == delimiters[DelimiterKind::list];
 }
 
-inline bool is_string_delimited(const std::string& token)
+inline bool is_string_delimited(std::string_view token)
 {
         return token.at(0) == delimiters[DelimiterKind::string];
 }
@@ -51,12 +53,28 @@ enum class KeywordKind {
         local_assignment,
         function,
         conditional_if,
+        frame_memory,
 };
 
 static std::unordered_map<KeywordKind, std::string> keywords = {
     {KeywordKind::definition, "def"},       {KeywordKind::assignment, "set"},
     {KeywordKind::local_assignment, "let"}, {KeywordKind::function, "fn"},
     {KeywordKind::conditional_if, "if"},
+    {KeywordKind::frame_memory, "frame-memory"},
+};
+
+// Keywords are interned once so detecting a special form is an integer
+// comparison.
+static std::unordered_map<KeywordKind, symbols::SymbolId> keyword_symbols = {
+    {KeywordKind::definition, symbols::intern(keywords[KeywordKind::definition])},
+    {KeywordKind::assignment, symbols::intern(keywords[KeywordKind::assignment])},
+    {KeywordKind::local_assignment,
+     symbols::intern(keywords[KeywordKind::local_assignment])},
+    {KeywordKind::function, symbols::intern(keywords[KeywordKind::function])},
+    {KeywordKind::conditional_if,
+     symbols::intern(keywords[KeywordKind::conditional_if])},
+    {KeywordKind::frame_memory,
+     symbols::intern(keywords[KeywordKind::frame_memory])},
 };
 
 // Helper Function
@@ -65,9 +83,9 @@ inline bool out_of_bounds(size_t index, size_t size) { return index >= size; }
 
 // Definition Selectors
 
-inline bool is_definition(const std::string& symbol)
+inline bool is_definition(symbols::SymbolId symbol)
 {
-        return symbol == keywords[KeywordKind::definition];
+        return symbol == keyword_symbols[KeywordKind::definition];
 }
 
 inline type::LisppObject definition_name(const type::LisppObject& expression)
@@ -77,12 +95,12 @@ inline type::LisppObject definition_name(const type::LisppObject& expression)
         // _^___^______^______
         //  0   1      2
         size_t name_pos = 1;
-        if (out_of_bounds(name_pos, expression.items.size())) {
+        if (out_of_bounds(name_pos, expression.items().size())) {
                 throw exception::ill_form_error("missing definition name\n\n"
                                                 "(def <name> <value>)\n"
                                                 "_____^______________");
         }
-        return expression.items.at(name_pos);
+        return expression.items().at(name_pos);
 }
 
 inline type::LisppObject definition_value(const type::LisppObject& expression)
@@ -92,19 +110,19 @@ inline type::LisppObject definition_value(const type::LisppObject& expression)
         // _^___^______^_______
         //  0   1      2
         size_t value_pos = 2;
-        if (out_of_bounds(value_pos, expression.items.size())) {
+        if (out_of_bounds(value_pos, expression.items().size())) {
                 throw exception::ill_form_error("missing definition value\n\n"
                                                 "(def <name> <value>)\n"
                                                 "____________^_______");
         }
-        return expression.items.at(value_pos);
+        return expression.items().at(value_pos);
 }
 
 // Assignment Selectors
 
-inline bool is_assigment(const std::string& symbol)
+inline bool is_assigment(symbols::SymbolId symbol)
 {
-        return symbol == keywords[KeywordKind::assignment];
+        return symbol == keyword_symbols[KeywordKind::assignment];
 }
 
 inline type::LisppObject variable_name(const type::LisppObject& expression)
@@ -114,12 +132,12 @@ inline type::LisppObject variable_name(const type::LisppObject& expression)
         // _^___^______^________
         //  0   1      2
         size_t name_pos = 1;
-        if (out_of_bounds(name_pos, expression.items.size())) {
+        if (out_of_bounds(name_pos, expression.items().size())) {
                 throw exception::ill_form_error("missing variable name\n\n"
                                                 "(set <name> <update>)\n"
                                                 "_____^_______________");
         }
-        return expression.items.at(name_pos);
+        return expression.items().at(name_pos);
 }
 
 inline type::LisppObject variable_update(const type::LisppObject& expression)
@@ -129,19 +147,19 @@ inline type::LisppObject variable_update(const type::LisppObject& expression)
         // _^___^______^________
         //  0   1      2
         size_t update_pos = 2;
-        if (out_of_bounds(update_pos, expression.items.size())) {
+        if (out_of_bounds(update_pos, expression.items().size())) {
                 throw exception::ill_form_error("missing variable update\n\n"
                                                 "(set <name> <update>)\n"
                                                 "____________^________");
         }
-        return expression.items.at(update_pos);
+        return expression.items().at(update_pos);
 }
 
 // Local Assignment Selectors
 
-inline bool is_local_assignment(const std::string& symbol)
+inline bool is_local_assignment(symbols::SymbolId symbol)
 {
-        return symbol == keywords[KeywordKind::local_assignment];
+        return symbol == keyword_symbols[KeywordKind::local_assignment];
 }
 
 inline std::vector<type::LisppObject>
@@ -152,14 +170,14 @@ local_variables(const type::LisppObject& expression)
         // _^___^________________^______
         //  0   1                2
         size_t variables_pos = 1;
-        if (out_of_bounds(variables_pos, expression.items.size())) {
+        if (out_of_bounds(variables_pos, expression.items().size())) {
                 throw exception::ill_form_error(
                     "missing local names.\n\n"
                     "(let (<name> <value>) <body>)\n"
                     "_____^_______________________");
         }
-        auto variables = expression.items.at(variables_pos);
-        return variables.items;
+        const auto& variables = expression.items().at(variables_pos).items();
+        return {variables.begin(), variables.end()};
 }
 
 inline type::LisppObject local_body(const type::LisppObject& expression)
@@ -169,20 +187,20 @@ inline type::LisppObject local_body(const type::LisppObject& expression)
         // _^___^________________^______
         //  0   1                2
         size_t body_pos = 2;
-        if (out_of_bounds(body_pos, expression.items.size())) {
+        if (out_of_bounds(body_pos, expression.items().size())) {
                 throw exception::ill_form_error(
                     "missing local assignment body.\n\n"
                     "(let (<name> <value>) <body>)\n"
                     "______________________^______");
         }
-        return expression.items.at(body_pos);
+        return expression.items().at(body_pos);
 }
 
 // Function Selectors
 
-inline bool is_function(const std::string& symbol)
+inline bool is_function(symbols::SymbolId symbol)
 {
-        return symbol == keywords[KeywordKind::function];
+        return symbol == keyword_symbols[KeywordKind::function];
 }
 
 inline std::vector<type::LisppObject>
@@ -193,14 +211,15 @@ function_parameters(const type::LisppObject& expression)
         // _^___^______________^______
         //  0   1              2
         size_t parameters_pos = 1;
-        if (out_of_bounds(parameters_pos, expression.items.size())) {
+        if (out_of_bounds(parameters_pos, expression.items().size())) {
                 throw exception::ill_form_error(
                     "missing function paramters.\n\n"
                     "(fn (<parameters>) <body>)\n"
                     "____^_____________________");
         }
-        auto parameters = expression.items.at(parameters_pos);
-        return parameters.items;
+        const auto& parameters =
+            expression.items().at(parameters_pos).items();
+        return {parameters.begin(), parameters.end()};
 }
 
 inline type::LisppObject function_body(const type::LisppObject& expression)
@@ -210,47 +229,41 @@ inline type::LisppObject function_body(const type::LisppObject& expression)
         // _^___^______________^______
         //  0   1              2
         size_t body_pos = 2;
-        if (out_of_bounds(body_pos, expression.items.size())) {
+        if (out_of_bounds(body_pos, expression.items().size())) {
                 throw exception::ill_form_error("missing function body.\n\n"
                                                 "(fn (<parameters>) <body>)\n"
                                                 "___________________^______");
         }
-        return expression.items.at(body_pos);
+        return expression.items().at(body_pos);
 }
 
 // Apply Selectors
 
-inline type::LisppObject apply_function(const type::LisppObject& expression)
+inline const type::LisppObject&
+apply_function(const type::LisppObject& expression)
 {
         // function_pos: 0 (front)
         // (<function-name> <arg-1> ... <arg-n>)
         // _^_______________^___________^_______
         //  0               1           n
-        auto function = expression.items.front();
-        if (!function.is_function()) {
-                throw exception::ill_form_error("object is not callable");
-        }
-        return function;
+        return expression.items().front();
 }
 
-inline std::vector<type::LisppObject>
-apply_arguments(const type::LisppObject& expression)
+inline type::List apply_arguments(const type::LisppObject& expression)
 {
         // arguments_pos: [1, n]
         // (<function-name> <arg-1> ... <arg-n>)
         // _^_______________^___________^_______
         //  0               1           n
         // TODO: Make sure number operands are same as what's expected?
-        std::vector<type::LisppObject> l{expression.items};
-        std::vector<type::LisppObject> arguments{l.begin() + 1, l.end()};
-        return arguments;
+        return expression.items().rest();
 }
 
 // If Selectors
 
-inline bool is_if(const std::string& symbol)
+inline bool is_if(symbols::SymbolId symbol)
 {
-        return symbol == keywords[KeywordKind::conditional_if];
+        return symbol == keyword_symbols[KeywordKind::conditional_if];
 }
 
 inline type::LisppObject if_predicate(const type::LisppObject& expression)
@@ -260,13 +273,13 @@ inline type::LisppObject if_predicate(const type::LisppObject& expression)
         // _^___^____________^____________^_____________
         //  0   1            2            3
         size_t predicate_pos = 1;
-        if (out_of_bounds(predicate_pos, expression.items.size())) {
+        if (out_of_bounds(predicate_pos, expression.items().size())) {
                 throw exception::ill_form_error(
                     "missing predicate.\n\n"
                     "(if (<predicate>) <consequent> <?-alternative>)\n"
                     "_____^_________________________________________");
         }
-        return expression.items.at(predicate_pos);
+        return expression.items().at(predicate_pos);
 }
 
 inline type::LisppObject if_consequent(const type::LisppObject& expression)
@@ -276,22 +289,29 @@ inline type::LisppObject if_consequent(const type::LisppObject& expression)
         // _^___^____________^____________^______________
         //  0   1            2            3
         size_t consequent_pos = 2;
-        if (out_of_bounds(consequent_pos, expression.items.size())) {
+        if (out_of_bounds(consequent_pos, expression.items().size())) {
                 throw exception::ill_form_error(
                     "missing consequent.\n\n"
                     "(if (<predicate>) <consequent> <?-alternative>)\n"
                     "__________________^____________________________");
         }
-        return expression.items.at(consequent_pos);
+        return expression.items().at(consequent_pos);
 }
 
 inline type::LisppObject if_alternative(const type::LisppObject& expression)
 {
         size_t alternative_pos = 3;
-        if (expression.items.size() < 4) {
+        if (expression.items().size() < 4) {
                 return type::LisppObject::create_nil();
         }
-        return expression.items.at(alternative_pos);
+        return expression.items().at(alternative_pos);
+}
+
+// Frame Memory Selectors
+
+inline bool is_frame_memory(symbols::SymbolId symbol)
+{
+        return symbol == keyword_symbols[KeywordKind::frame_memory];
 }
 
 } // namespace syntax
@@ -0,0 +1,113 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <string_view>
+
+#include "heap.h"
+
+namespace type {
+
+// Immutable characters, stored inline after the header so a buffer costs a
+// single allocation.
+class CharBuffer : public HeapObject {
+      public:
+        // A buffer of `size` characters, left for the caller to fill.
+        static CharBuffer* create(size_t size);
+        static CharBuffer* create(std::string_view text);
+
+        static void operator delete(void* memory) { deallocate_cell(memory); }
+
+
+        char* chars() { return reinterpret_cast<char*>(this + 1); }
+        const char* chars() const
+        {
+                return reinterpret_cast<const char*>(this + 1);
+        }
+
+        size_t size_in_bytes() const override { return sizeof(CharBuffer) + size; }
+
+        const size_t size;
+
+      private:
+        explicit CharBuffer(size_t size) : size{size} {}
+};
+
+// String Payload
+//
+// A string is either a window onto a character buffer or a rope: the
+// concatenation of two strings. Slicing a string shares its buffer, and
+// concatenating two strings only allocates the rope node, so building a
+// long string piece by piece stays linear. A rope's characters are gathered
+// into one buffer the first time they are read (printed, compared, hashed
+// or sliced), after which it is an ordinary window.
+class StringCell : public HeapObject {
+      public:
+        // A fresh string holding a copy of `text`.
+        static StringCell* create(std::string_view text);
+
+        // The characters in [start, end) of `string`, sharing its buffer.
+        static StringCell* slice(const StringCell& string, size_t start,
+                                 size_t end);
+
+        // `left` followed by `right`. Short results are copied flat; longer
+        // ones become a rope node.
+        static StringCell* concat(StringCell* left, StringCell* right);
+
+        ~StringCell() override;
+
+        size_t size_in_bytes() const override { return sizeof(StringCell); }
+
+        void trace(CellVisitor& visit) const override
+        {
+                visit(buffer.get());
+                visit(left.get());
+                visit(right.get());
+        }
+
+        size_t size() const { return length; }
+
+        std::string_view view() const
+        {
+                if (!buffer) {
+                        flatten();
+                }
+                return {buffer->chars() + offset, length};
+        }
+
+        size_t hash() const
+        {
+                if (cached_hash == 0) {
+                        cached_hash = std::hash<std::string_view>{}(view());
+                }
+                return cached_hash;
+        }
+
+      private:
+        StringCell(Ref<CharBuffer> buffer, size_t offset, size_t length)
+            : buffer{std::move(buffer)}, offset{offset}, length{length}
+        {
+        }
+        StringCell(StringCell* left, StringCell* right)
+            : length{left->length + right->length}, left{left}, right{right}
+        {
+        }
+
+        // Copies a rope's leaves into one buffer and drops its children.
+        void flatten() const;
+
+        // Set for windows, and for ropes once flattened.
+        mutable Ref<CharBuffer> buffer;
+        mutable size_t offset = 0;
+        size_t length;
+        // The halves of a rope that has not been flattened yet.
+        mutable Ref<StringCell> left;
+        mutable Ref<StringCell> right;
+        mutable size_t cached_hash = 0;
+};
+
+} // namespace type
+
+#endif // TEXT_H
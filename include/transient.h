@@ -0,0 +1,102 @@
+#ifndef TRANSIENT_H
+#define TRANSIENT_H
+
+#include <cstddef>
+
+#include "gc.h"
+#include "heap.h"
+#include "list.h"
+#include "map.h"
+#include "sorted_map.h"
+#include "type.h"
+
+namespace type {
+
+// Transient Builder
+//
+// A locally mutable copy of a list, hash map or sorted map for bulk
+// construction. Edits go straight into the wrapped collection: nodes it
+// shares with the source are copied on first touch and edited in place from
+// then on, so n edits cost O(n) rather than a fresh value per step.
+// `persistent` hands the collection back as an immutable value in O(1) and
+// retires the builder; using it afterwards is an error.
+class Transient {
+      public:
+        explicit Transient(const LisppObject& collection);
+
+        // Appends to a list builder.
+        void conj(LisppObject value);
+        // Adds or replaces an entry of a map builder.
+        void assoc(LisppObject key, LisppObject value);
+        // Removes an entry of a map builder.
+        void dissoc(const LisppObject& key);
+
+        size_t size() const;
+
+        LisppObject persistent();
+
+        // Empties the builder and retires it.
+        void clear()
+        {
+                editable = false;
+                list = List{};
+                map = Map{};
+                sorted_map = SortedMap{};
+        }
+
+        void trace(CellVisitor& visit) const
+        {
+                list.trace(visit);
+                map.trace(visit);
+                sorted_map.trace(visit);
+        }
+
+      private:
+        void check(Type expected) const;
+
+        Type kind;
+        bool editable = true;
+        List list;
+        Map map;
+        SortedMap sorted_map;
+};
+
+struct TransientCell : HeapObject {
+        explicit TransientCell(Transient transient)
+            : transient(std::move(transient))
+        {
+                // A builder can be added to itself.
+                cyclic = true;
+        }
+
+        size_t size_in_bytes() const override { return sizeof(TransientCell); }
+        void trace(CellVisitor& visit) const override
+        {
+                transient.trace(visit);
+        }
+        void drop_references() override { transient.clear(); }
+
+        Transient transient;
+};
+
+// Builders are mutable by design: every reference sees the same edits.
+inline Transient* LisppObject::transient()
+{
+        if (!is_transient()) {
+                return nullptr;
+        }
+        if (data.heap->traced) {
+                gc::shade_references(*data.heap);
+        }
+        return &static_cast<TransientCell*>(data.heap)->transient;
+}
+
+inline LisppObject LisppObject::create_transient(Transient transient)
+{
+        return create_heap(Type::Transient,
+                           new TransientCell{std::move(transient)});
+}
+
+} // namespace type
+
+#endif // TRANSIENT_H
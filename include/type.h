@@ -1,89 +1,519 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <list>
+#include <new>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "bignum.h"
+#include "decimal.h"
+#include "heap.h"
+#include "small_vector.h"
+#include "symbols.h"
+#include "text.h"
+
+class Frame;
+
 namespace type {
 
-// TODO: Come up with a boolean type instead of this True/False type hack. 
-enum class Type { Nil, True, False, Number, String, List, Symbol, Function };
+// TODO: Come up with a boolean type instead of this True/False type hack.
+// Immediate kinds come first and heap kinds from `Bignum` on, so telling
+// them apart is a single comparison.
+enum class Type : uint8_t {
+        Nil,
+        True,
+        False,
+        Number,
+        Integer,
+        Symbol,
+        Builtin,
+        Decimal,
+        Bignum,
+        BigDecimal,
+        String,
+        List,
+        Pair,
+        Map,
+        SortedMap,
+        F64Vec,
+        Bytes,
+        Transient,
+        Function
+};
 
 static std::unordered_map<Type, std::string> types = {
     {Type::Nil, "nil"},       {Type::True, "true"},
     {Type::False, "false"},   {Type::Number, "number"},
-    {Type::String, "string"}, {Type::List, "list"},
-    {Type::Symbol, "symbol"}, {Type::Function, "function"}};
-
-struct LisppObject {
-        Type type = Type::Nil;
-        double number = 0.0;
-        std::string symbol;
-        std::string string;
-        std::vector<LisppObject> items;
-        std::function<LisppObject(std::vector<LisppObject>)> lambda;
-
-        bool is_number() const { return type == Type::Number; }
-        bool is_string() const { return type == Type::String; }
-        bool is_symbol() const { return type == Type::Symbol; }
-        bool is_list() const { return type == Type::List; }
-        bool is_true() const { return type == Type::True; }
-        bool is_false() const { return type == Type::False; }
-        bool is_function() const { return type == Type::Function; }
-        bool is_nil() const { return type == Type::Nil; }
-
-        static LisppObject create_nil()
-        {
-                LisppObject exp{.type = Type::Nil};
-                return exp;
+    {Type::Integer, "integer"}, {Type::Bignum, "bignum"},
+    {Type::Decimal, "decimal"}, {Type::BigDecimal, "decimal"},
+    {Type::String, "string"},
+    {Type::List, "list"},     {Type::Pair, "pair"},
+    {Type::Map, "map"},       {Type::SortedMap, "sorted-map"},
+    {Type::F64Vec, "f64vec"},   {Type::Bytes, "bytes"},
+    {Type::Transient, "transient"},
+    {Type::Symbol, "symbol"},   {Type::Builtin, "builtin"},
+    {Type::Function, "function"}};
+
+class LisppObject;
+class List;
+class Map;
+class SortedMap;
+class F64Vec;
+class Bytes;
+class Transient;
+
+struct Closure;
+
+// Arguments to a call, stored inline for the common short call.
+using Arguments = SmallVector<LisppObject, 6>;
+
+// A core operator: a plain function, stored in the value itself.
+using Builtin = LisppObject (*)(Arguments);
+
+struct BignumCell : HeapObject {
+        explicit BignumCell(bignum::BigInt value) : value(std::move(value)) {}
+
+        size_t size_in_bytes() const override
+        {
+                return sizeof(BignumCell) +
+                       value.magnitude().capacity() * sizeof(uint32_t);
+        }
+
+        bignum::BigInt value;
+};
+
+struct DecimalCell : HeapObject {
+        explicit DecimalCell(decimal::Decimal value) : value(std::move(value))
+        {
+        }
+
+        size_t size_in_bytes() const override
+        {
+                return sizeof(DecimalCell) +
+                       value.unscaled.magnitude().capacity() * sizeof(uint32_t);
+        }
+
+        decimal::Decimal value;
+};
+
+// Tagged Value
+//
+// A 16-byte value: a type tag plus either an immediate payload (nil, booleans,
+// doubles, 64-bit integers, interned symbol ids and decimals whose unscaled
+// part fits in 64 bits, with their scale in the spare byte after the tag) or
+// a pointer to a heap cell (bignums, big decimals, strings, collections and
+// functions).
+
+class LisppObject {
+      public:
+        LisppObject() = default;
+        LisppObject(const LisppObject& other)
+            : tag{other.tag}, scale{other.scale}, data{other.data}
+        {
+                retain();
+        }
+        LisppObject(LisppObject&& other) noexcept
+            : tag{other.tag}, scale{other.scale}, data{other.data}
+        {
+                other.tag = Type::Nil;
+                other.data.heap = nullptr;
+        }
+        LisppObject& operator=(const LisppObject& other)
+        {
+                LisppObject copy{other};
+                swap(copy);
+                return *this;
+        }
+        LisppObject& operator=(LisppObject&& other) noexcept
+        {
+                LisppObject moved{std::move(other)};
+                swap(moved);
+                return *this;
+        }
+        ~LisppObject() { release(); }
+
+        Type type() const { return tag; }
+
+        // Passes the cell this value points to, if any, to `visit`.
+        void trace(CellVisitor& visit) const
+        {
+                if (is_heap()) {
+                        visit(data.heap);
+                }
+        }
+
+        bool is_number() const
+        {
+                return is_float() || is_integer() || is_bignum() ||
+                       is_decimal();
         }
+        bool is_float() const { return tag == Type::Number; }
+        bool is_integer() const { return tag == Type::Integer; }
+        bool is_bignum() const { return tag == Type::Bignum; }
+        bool is_exact() const { return is_integer() || is_bignum(); }
+        bool is_decimal() const
+        {
+                return tag == Type::Decimal || tag == Type::BigDecimal;
+        }
+        bool is_string() const { return tag == Type::String; }
+        bool is_symbol() const { return tag == Type::Symbol; }
+        bool is_list() const { return tag == Type::List; }
+        bool is_pair() const { return tag == Type::Pair; }
+        bool is_map() const { return tag == Type::Map; }
+        bool is_sorted_map() const { return tag == Type::SortedMap; }
+        bool is_f64vec() const { return tag == Type::F64Vec; }
+        bool is_bytes() const { return tag == Type::Bytes; }
+        bool is_transient() const { return tag == Type::Transient; }
+        bool is_true() const { return tag == Type::True; }
+        bool is_false() const { return tag == Type::False; }
+        bool is_function() const
+        {
+                return tag == Type::Function || tag == Type::Builtin;
+        }
+        bool is_builtin() const { return tag == Type::Builtin; }
+        bool is_closure() const { return tag == Type::Function; }
+        bool is_nil() const { return tag == Type::Nil; }
+
+        // Payload accessors. Reading the payload of a value of another type
+        // yields the type's empty value, as the old by-value members did.
+
+        // Exact integers are promoted to double when read as a `number()`.
+        double number() const
+        {
+                if (is_integer()) {
+                        return static_cast<double>(data.integer);
+                }
+                if (is_bignum()) {
+                        return cell<BignumCell>()->value.to_double();
+                }
+                if (is_decimal()) {
+                        return decimal::to_double(decimal());
+                }
+                return is_float() ? data.number : 0.0;
+        }
+
+        // Any exact integer, fixed-width or not, as a bignum.
+        bignum::BigInt bigint() const
+        {
+                return is_bignum() ? cell<BignumCell>()->value
+                                   : bignum::BigInt{integer()};
+        }
+
+        int64_t integer() const { return is_integer() ? data.integer : 0; }
+
+        // Any decimal, immediate or not, or an exact integer at scale 0.
+        decimal::Decimal decimal() const
+        {
+                if (tag == Type::BigDecimal) {
+                        return cell<DecimalCell>()->value;
+                }
+                if (tag == Type::Decimal) {
+                        return decimal::Decimal{data.integer, scale};
+                }
+                return decimal::Decimal{bigint(), 0};
+        }
+
+        // The unscaled part of an immediate decimal.
+        int64_t decimal_unscaled() const
+        {
+                return tag == Type::Decimal ? data.integer : 0;
+        }
+
+        // Digits after the point of any decimal; 0 for other numbers.
+        uint32_t decimal_scale() const
+        {
+                if (tag == Type::BigDecimal) {
+                        return cell<DecimalCell>()->value.scale;
+                }
+                return tag == Type::Decimal ? scale : 0;
+        }
+
+        std::string_view string() const
+        {
+                return is_string() ? cell<StringCell>()->view()
+                                   : std::string_view{};
+        }
+
+        // The length of a string, without flattening a rope.
+        size_t string_size() const
+        {
+                return is_string() ? cell<StringCell>()->size() : 0;
+        }
+
+        size_t string_hash() const
+        {
+                return is_string() ? cell<StringCell>()->hash() : 0;
+        }
+
+        // Whether both values share one heap payload.
+        bool same_cell(const LisppObject& other) const
+        {
+                return is_heap() && tag == other.tag &&
+                       data.heap == other.data.heap;
+        }
+
+        const std::string& symbol() const
+        {
+                return is_symbol() ? symbols::name(data.symbol)
+                                   : empty_string();
+        }
+
+        symbols::SymbolId symbol_id() const { return data.symbol; }
+
+        const List& items() const;
+
+        const LisppObject& car() const;
+        const LisppObject& cdr() const;
+
+        const Map& map() const;
+        const SortedMap& sorted_map() const;
+
+        const F64Vec& f64vec() const;
+        // The vector for in-place update when this is its only reference.
+        F64Vec* unique_f64vec();
+
+        const Bytes& bytes() const;
+
+        Transient* transient();
+
+        Builtin builtin() const
+        {
+                return is_builtin() ? data.builtin : nullptr;
+        }
+
+        const Closure& closure() const;
+
+        static LisppObject create_nil() { return LisppObject{}; }
 
         static LisppObject create_number(double number)
         {
-                LisppObject exp{.type = Type::Number, .number = number};
+                LisppObject exp{Type::Number};
+                exp.data.number = number;
                 return exp;
         }
 
-        static LisppObject create_string(const std::string& string)
+        static LisppObject create_integer(int64_t integer)
         {
-                LisppObject exp{.type = Type::String, .string = string};
+                LisppObject exp{Type::Integer};
+                exp.data.integer = integer;
                 return exp;
         }
 
-        static LisppObject create_symbol(const std::string& symbol)
+        // Bignums that fit in 64 bits are demoted to immediate integers.
+        static LisppObject create_bignum(bignum::BigInt bigint)
         {
-                LisppObject exp{.type = Type::Symbol, .symbol = symbol};
+                if (bigint.fits_int64()) {
+                        return create_integer(bigint.to_int64());
+                }
+                return create_heap(Type::Bignum,
+                                   new BignumCell{std::move(bigint)});
+        }
+
+        static LisppObject create_decimal(int64_t unscaled, uint8_t scale)
+        {
+                LisppObject exp{Type::Decimal};
+                exp.scale = scale;
+                exp.data.integer = unscaled;
                 return exp;
         }
 
-        static LisppObject create_list(const std::vector<LisppObject>& list)
+        // Decimals that fit an immediate are demoted to one.
+        static LisppObject create_decimal(decimal::Decimal value)
+        {
+                if (value.unscaled.fits_int64() && value.scale <= UINT8_MAX) {
+                        return create_decimal(
+                            value.unscaled.to_int64(),
+                            static_cast<uint8_t>(value.scale));
+                }
+                return create_heap(Type::BigDecimal,
+                                   new DecimalCell{std::move(value)});
+        }
+
+        static LisppObject create_string(std::string_view string)
+        {
+                return create_heap(Type::String, StringCell::create(string));
+        }
+
+        // The characters in [start, end) of `string`, sharing its buffer.
+        static LisppObject create_substring(const LisppObject& string,
+                                            size_t start, size_t end)
+        {
+                return create_heap(Type::String,
+                                   StringCell::slice(*string.cell<StringCell>(),
+                                                     start, end));
+        }
+
+        // Two strings joined without copying either one.
+        static LisppObject create_concat(const LisppObject& left,
+                                         const LisppObject& right)
+        {
+                return create_heap(
+                    Type::String,
+                    StringCell::concat(static_cast<StringCell*>(left.data.heap),
+                                       static_cast<StringCell*>(right.data.heap)));
+        }
+
+        static LisppObject create_symbol(std::string_view symbol)
+        {
+                return create_symbol(symbols::intern(symbol));
+        }
+
+        static LisppObject create_symbol(symbols::SymbolId symbol)
+        {
+                LisppObject exp{Type::Symbol};
+                exp.data.symbol = symbol;
+                return exp;
+        }
+
+        static LisppObject create_list(const std::vector<LisppObject>& list);
+        static LisppObject create_list(List list);
+
+        static LisppObject create_pair(LisppObject car, LisppObject cdr);
+
+        static LisppObject create_map(Map map);
+        static LisppObject create_sorted_map(SortedMap map);
+
+        static LisppObject create_f64vec(F64Vec vec);
+
+        static LisppObject create_bytes(Bytes bytes);
+
+        static LisppObject create_transient(Transient transient);
+
+        static LisppObject create_builtin(Builtin builtin)
         {
-                LisppObject exp{.type = Type::List, .items = list};
+                LisppObject exp{Type::Builtin};
+                exp.data.builtin = builtin;
                 return exp;
         }
 
-        static LisppObject create_function(
-            std::function<LisppObject(std::vector<LisppObject>)> function)
+        static LisppObject create_closure(Closure closure);
+
+        static LisppObject create_true() { return LisppObject{Type::True}; }
+
+        static LisppObject create_false() { return LisppObject{Type::False}; }
+
+        static LisppObject create_boolean(bool value)
+        {
+                return LisppObject{value ? Type::True : Type::False};
+        }
+
+      private:
+        friend struct PairCell;
+
+        explicit LisppObject(Type tag) : tag{tag} {}
+
+        static LisppObject create_heap(Type tag, HeapObject* heap)
         {
-                LisppObject exp{.type = Type::Function, .lambda = function};
+                LisppObject exp{tag};
+                exp.data.heap = heap;
+                exp.retain();
                 return exp;
         }
 
-        static LisppObject create_true()
+        static const std::string& empty_string()
         {
-                LisppObject t{.type = Type::True};
-                return t;
+                static const std::string empty;
+                return empty;
         }
 
-        static LisppObject create_false()
+        // Immediates own no cell, so copying or dropping one never touches
+        // a refcount: nil, the booleans and every integer are in effect
+        // immortal constants.
+        bool is_heap() const { return tag >= Type::Bignum; }
+
+        template <typename Cell>
+        const Cell* cell() const
         {
-                LisppObject f{.type = Type::False};
-                return f;
+                return static_cast<const Cell*>(data.heap);
         }
+
+        void retain()
+        {
+                if (is_heap()) {
+                        type::retain(data.heap);
+                }
+        }
+
+        void release()
+        {
+                if (is_heap()) {
+                        type::release(data.heap);
+                }
+        }
+
+        void swap(LisppObject& other) noexcept
+        {
+                std::swap(tag, other.tag);
+                std::swap(scale, other.scale);
+                std::swap(data, other.data);
+        }
+
+        Type tag = Type::Nil;
+        // The scale of an immediate decimal; it fills tag padding.
+        uint8_t scale = 0;
+        union {
+                double number;
+                int64_t integer;
+                symbols::SymbolId symbol;
+                Builtin builtin;
+                HeapObject* heap;
+        } data{.heap = nullptr};
+};
+
+static_assert(sizeof(LisppObject) == 16, "LisppObject must stay two words");
+
+// A user function: its parameters, its body and the frame it closes over.
+// Copying a closure value shares the cell, never the body. The closure keeps
+// its frame alive; `env` always holds a `Frame`, which is incomplete here.
+struct Closure {
+        std::vector<symbols::SymbolId> parameters;
+        LisppObject body;
+        Ref<HeapObject> env;
+};
+
+struct ClosureCell : HeapObject {
+        explicit ClosureCell(Closure closure) : closure(std::move(closure)) {}
+
+        size_t size_in_bytes() const override
+        {
+                return sizeof(ClosureCell) + closure.parameters.capacity() *
+                                                 sizeof(symbols::SymbolId);
+        }
+
+        void trace(CellVisitor& visit) const override
+        {
+                closure.body.trace(visit);
+                visit(closure.env.get());
+        }
+
+        Closure closure;
 };
+
+inline const Closure& LisppObject::closure() const
+{
+        static const Closure empty;
+        return is_closure() ? cell<ClosureCell>()->closure : empty;
+}
+
+inline LisppObject LisppObject::create_closure(Closure closure)
+{
+        return create_heap(Type::Function, new ClosureCell{std::move(closure)});
+}
+
 } // namespace type
 
+// Collections need the complete LisppObject, so they are defined after it.
+#include "bytes.h"
+#include "f64vec.h"
+#include "list.h"
+#include "map.h"
+#include "sorted_map.h"
+
 #endif // TYPES_H
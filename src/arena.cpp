@@ -0,0 +1,48 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace arena;
+
+void* Arena::allocate(size_t size, size_t alignment)
+{
+        // Chunks left over from earlier forms are reused before new ones
+        // are added.
+        while (current < chunks.size()) {
+                Chunk& chunk = chunks[current];
+                size_t start = (used + alignment - 1) & ~(alignment - 1);
+                if (start + size <= chunk.size) {
+                        used = start + size;
+                        return chunk.memory.get() + start;
+                }
+                current++;
+                used = 0;
+        }
+        size_t bytes = std::max(chunk_bytes, size + alignment);
+        chunks.push_back(Chunk{std::unique_ptr<char[]>(new char[bytes]), bytes});
+        used = size;
+        return chunks.back().memory.get();
+}
+
+size_t Arena::capacity() const
+{
+        size_t total = 0;
+        for (const Chunk& chunk : chunks) {
+                total += chunk.size;
+        }
+        return total;
+}
+
+Arena& arena::current()
+{
+        static Arena arena;
+        return arena;
+}
+
+std::string_view arena::copy(std::string_view text)
+{
+        auto* chars = static_cast<char*>(current().allocate(text.size(), 1));
+        std::memcpy(chars, text.data(), text.size());
+        return {chars, text.size()};
+}
@@ -0,0 +1,398 @@
+#include "bignum.h"
+
+#include <algorithm>
+
+using bignum::BigInt;
+using Limbs = BigInt::Limbs;
+
+namespace {
+
+// Operands at least this many limbs long are multiplied with Karatsuba;
+// below it schoolbook multiplication is faster.
+constexpr size_t karatsuba_threshold = 32;
+
+void trim(Limbs& limbs)
+{
+        while (!limbs.empty() && limbs.back() == 0) {
+                limbs.pop_back();
+        }
+}
+
+int compare_magnitude(const Limbs& a, const Limbs& b)
+{
+        if (a.size() != b.size()) {
+                return a.size() < b.size() ? -1 : 1;
+        }
+        for (size_t i = a.size(); i-- > 0;) {
+                if (a[i] != b[i]) {
+                        return a[i] < b[i] ? -1 : 1;
+                }
+        }
+        return 0;
+}
+
+Limbs add_magnitude(const Limbs& a, const Limbs& b)
+{
+        const Limbs& longer = a.size() >= b.size() ? a : b;
+        const Limbs& shorter = a.size() >= b.size() ? b : a;
+        Limbs sum(longer.size() + 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < longer.size(); i++) {
+                uint64_t s = carry + longer[i];
+                if (i < shorter.size()) {
+                        s += shorter[i];
+                }
+                sum[i] = static_cast<uint32_t>(s);
+                carry = s >> 32;
+        }
+        sum[longer.size()] = static_cast<uint32_t>(carry);
+        trim(sum);
+        return sum;
+}
+
+// Requires |a| >= |b|.
+Limbs sub_magnitude(const Limbs& a, const Limbs& b)
+{
+        Limbs diff(a.size());
+        int64_t borrow = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+                int64_t d = static_cast<int64_t>(a[i]) - borrow;
+                if (i < b.size()) {
+                        d -= b[i];
+                }
+                borrow = d < 0;
+                diff[i] = static_cast<uint32_t>(d + (borrow << 32));
+        }
+        trim(diff);
+        return diff;
+}
+
+// Adds `b`, shifted up by `shift` limbs, into `a` in place.
+void add_shifted(Limbs& a, const Limbs& b, size_t shift)
+{
+        if (a.size() < b.size() + shift + 1) {
+                a.resize(b.size() + shift + 1, 0);
+        }
+        uint64_t carry = 0;
+        size_t i = 0;
+        for (; i < b.size(); i++) {
+                uint64_t s = carry + a[i + shift] + b[i];
+                a[i + shift] = static_cast<uint32_t>(s);
+                carry = s >> 32;
+        }
+        for (i += shift; carry != 0; i++) {
+                if (i == a.size()) {
+                        a.push_back(0);
+                }
+                uint64_t s = carry + a[i];
+                a[i] = static_cast<uint32_t>(s);
+                carry = s >> 32;
+        }
+}
+
+Limbs schoolbook_multiply(const Limbs& a, const Limbs& b)
+{
+        if (a.empty() || b.empty()) {
+                return {};
+        }
+        Limbs prod(a.size() + b.size(), 0);
+        for (size_t i = 0; i < a.size(); i++) {
+                uint64_t carry = 0;
+                for (size_t j = 0; j < b.size(); j++) {
+                        uint64_t p = static_cast<uint64_t>(a[i]) * b[j] +
+                                     prod[i + j] + carry;
+                        prod[i + j] = static_cast<uint32_t>(p);
+                        carry = p >> 32;
+                }
+                prod[i + b.size()] = static_cast<uint32_t>(carry);
+        }
+        trim(prod);
+        return prod;
+}
+
+Limbs low_half(const Limbs& limbs, size_t split)
+{
+        Limbs low{limbs.begin(),
+                  limbs.begin() + std::min(split, limbs.size())};
+        trim(low);
+        return low;
+}
+
+Limbs high_half(const Limbs& limbs, size_t split)
+{
+        if (limbs.size() <= split) {
+                return {};
+        }
+        return Limbs{limbs.begin() + split, limbs.end()};
+}
+
+// Karatsuba: with x = x1*B^m + x0 and y = y1*B^m + y0,
+// x*y = z2*B^2m + (z1 - z2 - z0)*B^m + z0, where z1 = (x0 + x1)(y0 + y1).
+Limbs multiply_magnitude(const Limbs& a, const Limbs& b)
+{
+        if (std::min(a.size(), b.size()) < karatsuba_threshold) {
+                return schoolbook_multiply(a, b);
+        }
+        size_t split = std::max(a.size(), b.size()) / 2;
+        Limbs a0 = low_half(a, split);
+        Limbs a1 = high_half(a, split);
+        Limbs b0 = low_half(b, split);
+        Limbs b1 = high_half(b, split);
+
+        Limbs z0 = multiply_magnitude(a0, b0);
+        Limbs z2 = multiply_magnitude(a1, b1);
+        Limbs z1 = multiply_magnitude(add_magnitude(a0, a1),
+                                      add_magnitude(b0, b1));
+        z1 = sub_magnitude(sub_magnitude(z1, z0), z2);
+
+        Limbs prod = z0;
+        add_shifted(prod, z1, split);
+        add_shifted(prod, z2, 2 * split);
+        trim(prod);
+        return prod;
+}
+
+Limbs divmod_small(const Limbs& a, uint32_t divisor, uint32_t& remainder)
+{
+        Limbs quotient(a.size());
+        uint64_t rem = 0;
+        for (size_t i = a.size(); i-- > 0;) {
+                uint64_t cur = (rem << 32) | a[i];
+                quotient[i] = static_cast<uint32_t>(cur / divisor);
+                rem = cur % divisor;
+        }
+        trim(quotient);
+        remainder = static_cast<uint32_t>(rem);
+        return quotient;
+}
+
+// Knuth's Algorithm D (TAOCP 4.3.1) on 32-bit limbs. Requires v.size() > 1.
+void divmod_magnitude(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r)
+{
+        const size_t n = v.size();
+        const size_t m = u.size() - n;
+        const int s = __builtin_clz(v.back());
+
+        // Normalize so the divisor's top limb has its high bit set.
+        Limbs vn(n), un(u.size() + 1);
+        for (size_t i = n - 1; i > 0; i--) {
+                vn[i] = (v[i] << s) |
+                        static_cast<uint32_t>((uint64_t{v[i - 1]} >> (32 - s)));
+        }
+        vn[0] = v[0] << s;
+        un[u.size()] =
+            static_cast<uint32_t>(uint64_t{u[u.size() - 1]} >> (32 - s));
+        for (size_t i = u.size() - 1; i > 0; i--) {
+                un[i] = (u[i] << s) |
+                        static_cast<uint32_t>((uint64_t{u[i - 1]} >> (32 - s)));
+        }
+        un[0] = u[0] << s;
+
+        const uint64_t base = uint64_t{1} << 32;
+        q.assign(m + 1, 0);
+        for (size_t j = m + 1; j-- > 0;) {
+                uint64_t numerator = (uint64_t{un[j + n]} << 32) | un[j + n - 1];
+                uint64_t qhat = numerator / vn[n - 1];
+                uint64_t rhat = numerator % vn[n - 1];
+                while (qhat >= base ||
+                       qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+                        qhat--;
+                        rhat += vn[n - 1];
+                        if (rhat >= base) {
+                                break;
+                        }
+                }
+
+                // Multiply and subtract qhat * vn from the window of un.
+                int64_t borrow = 0;
+                int64_t t = 0;
+                for (size_t i = 0; i < n; i++) {
+                        uint64_t p = qhat * vn[i];
+                        t = un[i + j] - borrow -
+                            static_cast<int64_t>(p & 0xFFFFFFFF);
+                        un[i + j] = static_cast<uint32_t>(t);
+                        borrow = static_cast<int64_t>(p >> 32) - (t >> 32);
+                }
+                t = un[j + n] - borrow;
+                un[j + n] = static_cast<uint32_t>(t);
+
+                q[j] = static_cast<uint32_t>(qhat);
+                if (t < 0) {
+                        // qhat was one too large: add the divisor back.
+                        q[j]--;
+                        uint64_t carry = 0;
+                        for (size_t i = 0; i < n; i++) {
+                                uint64_t sum =
+                                    uint64_t{un[i + j]} + vn[i] + carry;
+                                un[i + j] = static_cast<uint32_t>(sum);
+                                carry = sum >> 32;
+                        }
+                        un[j + n] += static_cast<uint32_t>(carry);
+                }
+        }
+
+        // Unnormalize the remainder.
+        r.assign(n, 0);
+        for (size_t i = 0; i < n; i++) {
+                r[i] = (un[i] >> s) |
+                       static_cast<uint32_t>((uint64_t{un[i + 1]} << (32 - s)));
+        }
+        trim(q);
+        trim(r);
+}
+
+} // namespace
+
+BigInt::BigInt(int64_t value) : negative{value < 0}
+{
+        // Negate in unsigned arithmetic so INT64_MIN is representable.
+        uint64_t magnitude = negative ? ~static_cast<uint64_t>(value) + 1
+                                      : static_cast<uint64_t>(value);
+        while (magnitude != 0) {
+                limbs.push_back(static_cast<uint32_t>(magnitude));
+                magnitude >>= 32;
+        }
+}
+
+BigInt::BigInt(bool negative, Limbs limbs)
+    : negative{negative}, limbs{std::move(limbs)}
+{
+        trim(this->limbs);
+        if (this->limbs.empty()) {
+                this->negative = false;
+        }
+}
+
+std::optional<BigInt> BigInt::from_string(std::string_view text)
+{
+        bool negative = !text.empty() && text.front() == '-';
+        if (negative) {
+                text.remove_prefix(1);
+        }
+        if (text.empty()) {
+                return std::nullopt;
+        }
+        Limbs limbs;
+        for (char c : text) {
+                if (c < '0' || c > '9') {
+                        return std::nullopt;
+                }
+                // limbs = limbs * 10 + digit
+                uint64_t carry = static_cast<uint64_t>(c - '0');
+                for (auto& limb : limbs) {
+                        uint64_t p = uint64_t{limb} * 10 + carry;
+                        limb = static_cast<uint32_t>(p);
+                        carry = p >> 32;
+                }
+                if (carry != 0) {
+                        limbs.push_back(static_cast<uint32_t>(carry));
+                }
+        }
+        return BigInt{negative, std::move(limbs)};
+}
+
+bool BigInt::fits_int64() const
+{
+        if (limbs.size() > 2) {
+                return false;
+        }
+        uint64_t magnitude = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+                magnitude = (magnitude << 32) | limbs[i];
+        }
+        uint64_t limit = uint64_t{1} << 63;
+        return negative ? magnitude <= limit : magnitude < limit;
+}
+
+int64_t BigInt::to_int64() const
+{
+        uint64_t magnitude = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+                magnitude = (magnitude << 32) | limbs[i];
+        }
+        return negative ? static_cast<int64_t>(~magnitude + 1)
+                        : static_cast<int64_t>(magnitude);
+}
+
+double BigInt::to_double() const
+{
+        double value = 0.0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+                value = value * 4294967296.0 + limbs[i];
+        }
+        return negative ? -value : value;
+}
+
+std::string BigInt::to_string() const
+{
+        if (is_zero()) {
+                return "0";
+        }
+        // Peel off nine decimal digits at a time.
+        std::string digits;
+        Limbs rest = limbs;
+        while (!rest.empty()) {
+                uint32_t chunk = 0;
+                rest = divmod_small(rest, 1000000000, chunk);
+                for (int i = 0; i < 9 && (!rest.empty() || chunk != 0); i++) {
+                        digits.push_back(static_cast<char>('0' + chunk % 10));
+                        chunk /= 10;
+                }
+        }
+        if (negative) {
+                digits.push_back('-');
+        }
+        std::reverse(digits.begin(), digits.end());
+        return digits;
+}
+
+BigInt BigInt::operator-() const { return BigInt{!negative, limbs}; }
+
+BigInt bignum::operator+(const BigInt& a, const BigInt& b)
+{
+        if (a.negative == b.negative) {
+                return BigInt{a.negative, add_magnitude(a.limbs, b.limbs)};
+        }
+        if (compare_magnitude(a.limbs, b.limbs) >= 0) {
+                return BigInt{a.negative, sub_magnitude(a.limbs, b.limbs)};
+        }
+        return BigInt{b.negative, sub_magnitude(b.limbs, a.limbs)};
+}
+
+BigInt bignum::operator-(const BigInt& a, const BigInt& b) { return a + (-b); }
+
+BigInt bignum::operator*(const BigInt& a, const BigInt& b)
+{
+        return BigInt{a.negative != b.negative,
+                      multiply_magnitude(a.limbs, b.limbs)};
+}
+
+void BigInt::divmod(const BigInt& a, const BigInt& b, BigInt& quotient,
+                    BigInt& remainder)
+{
+        Limbs q, r;
+        if (compare_magnitude(a.limbs, b.limbs) < 0) {
+                r = a.limbs;
+        }
+        else if (b.limbs.size() == 1) {
+                uint32_t rem = 0;
+                q = divmod_small(a.limbs, b.limbs[0], rem);
+                if (rem != 0) {
+                        r.push_back(rem);
+                }
+        }
+        else {
+                divmod_magnitude(a.limbs, b.limbs, q, r);
+        }
+        quotient = BigInt{a.negative != b.negative, std::move(q)};
+        remainder = BigInt{a.negative, std::move(r)};
+}
+
+int bignum::compare(const BigInt& a, const BigInt& b)
+{
+        if (a.negative != b.negative) {
+                return a.negative ? -1 : 1;
+        }
+        int magnitude = compare_magnitude(a.limbs, b.limbs);
+        return a.negative ? -magnitude : magnitude;
+}
@@ -0,0 +1,119 @@
+#include "bytes.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace type;
+
+namespace {
+
+// Bytes copied inline after the header, in one allocation.
+struct InlineBuffer : ByteBuffer {
+        static InlineBuffer* create(std::string_view bytes)
+        {
+                void* memory =
+                    allocate_cell(sizeof(InlineBuffer) + bytes.size());
+                auto* buffer = ::new (memory) InlineBuffer;
+                auto* storage = reinterpret_cast<uint8_t*>(buffer + 1);
+                std::memcpy(storage, bytes.data(), bytes.size());
+                buffer->data = storage;
+                buffer->size = bytes.size();
+                return buffer;
+        }
+
+        static void operator delete(void* memory) { deallocate_cell(memory); }
+};
+
+// A read-only private mapping of a whole file, unmapped with the buffer.
+struct MappedBuffer : ByteBuffer {
+        ~MappedBuffer() override
+        {
+                munmap(const_cast<uint8_t*>(data), size);
+        }
+};
+
+void check_range(size_t index, size_t width, size_t length)
+{
+        if (index > length || width > length - index) {
+                throw std::runtime_error("\n;Index out of range: " +
+                                         std::to_string(index) + ".\n");
+        }
+}
+
+} // namespace
+
+Bytes::Bytes(std::string_view bytes)
+    : buffer{InlineBuffer::create(bytes)}, length{bytes.size()}
+{
+}
+
+Bytes Bytes::map_file(const std::string& path)
+{
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+                throw std::runtime_error("\n;Cannot open file: " + path +
+                                         ".\n");
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+                close(fd);
+                throw std::runtime_error("\n;Cannot read file: " + path +
+                                         ".\n");
+        }
+        Bytes bytes;
+        auto size = static_cast<size_t>(info.st_size);
+        if (size > 0) {
+                void* mapping =
+                    mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping == MAP_FAILED) {
+                        close(fd);
+                        throw std::runtime_error("\n;Cannot map file: " +
+                                                 path + ".\n");
+                }
+                auto* buffer = new MappedBuffer;
+                buffer->data = static_cast<const uint8_t*>(mapping);
+                buffer->size = size;
+                bytes.buffer = Ref<ByteBuffer>{buffer};
+                bytes.length = size;
+        }
+        // The mapping stays valid once the descriptor is closed.
+        close(fd);
+        return bytes;
+}
+
+uint8_t Bytes::at(size_t index) const
+{
+        check_range(index, 1, length);
+        return (*this)[index];
+}
+
+Bytes Bytes::slice(size_t start, size_t end) const
+{
+        if (start > end || end > length) {
+                throw std::runtime_error("\n;Invalid slice [" +
+                                         std::to_string(start) + ", " +
+                                         std::to_string(end) + ").\n");
+        }
+        Bytes slice{*this};
+        slice.offset += start;
+        slice.length = end - start;
+        return slice;
+}
+
+uint64_t Bytes::read_unsigned(size_t index, size_t width,
+                              bool big_endian) const
+{
+        check_range(index, width, length);
+        const uint8_t* bytes = data() + index;
+        uint64_t value = 0;
+        for (size_t i = 0; i < width; i++) {
+                size_t byte = big_endian ? i : width - 1 - i;
+                value = (value << 8) | bytes[byte];
+        }
+        return value;
+}
@@ -0,0 +1,269 @@
+#include "compare.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+using namespace type;
+
+namespace {
+
+size_t combine(size_t seed, size_t hash)
+{
+        return seed ^ (hash + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+}
+
+// Where values of each kind fall relative to other kinds.
+int rank(const LisppObject& value)
+{
+        switch (value.type()) {
+        case Type::Nil:
+                return 0;
+        case Type::False:
+                return 1;
+        case Type::True:
+                return 2;
+        case Type::Number:
+        case Type::Integer:
+        case Type::Decimal:
+        case Type::Bignum:
+        case Type::BigDecimal:
+                return 3;
+        case Type::String:
+                return 4;
+        case Type::Symbol:
+                return 5;
+        case Type::List:
+                return 6;
+        default:
+                throw std::runtime_error("\n;Cannot order values of type " +
+                                         types[value.type()] + ".\n");
+        }
+}
+
+template <typename Sequence>
+int order_sequences(const Sequence& a, const Sequence& b)
+{
+        auto i = a.begin();
+        auto j = b.begin();
+        for (; i != a.end() && j != b.end(); ++i, ++j) {
+                if (int order = compare::order(*i, *j)) {
+                        return order;
+                }
+        }
+        return (j == b.end()) - (i == a.end());
+}
+
+} // namespace
+
+int compare::numbers(const LisppObject& a, const LisppObject& b)
+{
+        if (a.is_integer() && b.is_integer()) {
+                return (a.integer() > b.integer()) - (a.integer() < b.integer());
+        }
+        if (a.is_exact() && b.is_exact()) {
+                return bignum::compare(a.bigint(), b.bigint());
+        }
+        if ((a.is_decimal() || b.is_decimal()) && !a.is_float() &&
+            !b.is_float()) {
+                if (a.type() == Type::Decimal && b.type() == Type::Decimal &&
+                    a.decimal_scale() == b.decimal_scale()) {
+                        int64_t x = a.decimal_unscaled();
+                        int64_t y = b.decimal_unscaled();
+                        return (x > y) - (x < y);
+                }
+                return decimal::compare(a.decimal(), b.decimal());
+        }
+        return (a.number() > b.number()) - (a.number() < b.number());
+}
+
+int compare::order(const LisppObject& a, const LisppObject& b)
+{
+        int rank_a = rank(a);
+        int rank_b = rank(b);
+        if (rank_a != rank_b) {
+                return rank_a < rank_b ? -1 : 1;
+        }
+        switch (a.type()) {
+        case Type::Number:
+        case Type::Integer:
+        case Type::Decimal:
+        case Type::Bignum:
+        case Type::BigDecimal:
+                return numbers(a, b);
+        case Type::String:
+                return a.string().compare(b.string());
+        case Type::Symbol:
+                return a.symbol_id() == b.symbol_id()
+                           ? 0
+                           : a.symbol().compare(b.symbol());
+        case Type::List:
+                return order_sequences(a.items(), b.items());
+        default:
+                return 0;
+        }
+}
+
+bool compare::equal(const LisppObject& l1, const LisppObject& l2)
+{
+        if (l1.is_number() && l2.is_number()) {
+                return numbers(l1, l2) == 0;
+        }
+        if (l1.type() != l2.type()) {
+                return false;
+        }
+        switch (l1.type()) {
+        case Type::Nil:
+        case Type::True:
+        case Type::False:
+                return true;
+        case Type::String:
+                if (l1.same_cell(l2)) {
+                        return true;
+                }
+                if (l1.string_size() != l2.string_size() ||
+                    l1.string_hash() != l2.string_hash()) {
+                        return false;
+                }
+                return l1.string() == l2.string();
+        case Type::Symbol:
+                return l1.symbol_id() == l2.symbol_id();
+        case Type::Builtin:
+                return l1.builtin() == l2.builtin();
+        case Type::Transient:
+                return l1.same_cell(l2);
+        case Type::Pair: {
+                // Walk the spine iteratively; only cars recurse.
+                const LisppObject* a = &l1;
+                const LisppObject* b = &l2;
+                for (; a->is_pair() && b->is_pair();
+                     a = &a->cdr(), b = &b->cdr()) {
+                        if (!equal(a->car(), b->car())) {
+                                return false;
+                        }
+                }
+                return equal(*a, *b);
+        }
+        case Type::List: {
+                const auto& items1 = l1.items();
+                const auto& items2 = l2.items();
+                if (items1.size() != items2.size()) {
+                        return false;
+                }
+                for (auto i = items1.begin(), j = items2.begin();
+                     i != items1.end(); ++i, ++j) {
+                        if (!equal(*i, *j)) {
+                                return false;
+                        }
+                }
+                return true;
+        }
+        case Type::Map: {
+                const auto& map1 = l1.map();
+                const auto& map2 = l2.map();
+                if (map1.size() != map2.size()) {
+                        return false;
+                }
+                bool same = true;
+                map1.for_each([&](const LisppObject& key,
+                                  const LisppObject& value) {
+                        if (same) {
+                                const LisppObject* other = map2.find(key);
+                                same = other != nullptr && equal(value, *other);
+                        }
+                });
+                return same;
+        }
+        case Type::F64Vec: {
+                const auto& vec1 = l1.f64vec();
+                const auto& vec2 = l2.f64vec();
+                return vec1.size() == vec2.size() &&
+                       std::equal(vec1.data(), vec1.data() + vec1.size(),
+                                  vec2.data());
+        }
+        case Type::Bytes: {
+                const auto& bytes1 = l1.bytes();
+                const auto& bytes2 = l2.bytes();
+                return bytes1.size() == bytes2.size() &&
+                       std::equal(bytes1.data(), bytes1.data() + bytes1.size(),
+                                  bytes2.data());
+        }
+        case Type::SortedMap: {
+                const auto& map1 = l1.sorted_map();
+                const auto& map2 = l2.sorted_map();
+                if (map1.size() != map2.size()) {
+                        return false;
+                }
+                bool same = true;
+                map1.for_each([&](const LisppObject& key,
+                                  const LisppObject& value) {
+                        if (same) {
+                                const LisppObject* other = map2.find(key);
+                                same = other != nullptr && equal(value, *other);
+                        }
+                });
+                return same;
+        }
+        default:
+                return false;
+        }
+}
+
+size_t compare::hash(const LisppObject& value)
+{
+        if (value.is_number()) {
+                // Hash by double value, since numbers of different kinds
+                // compare equal by value. Fold -0.0 into 0.0.
+                double number = value.number();
+                return std::hash<double>{}(number == 0.0 ? 0.0 : number);
+        }
+        size_t seed = static_cast<size_t>(value.type());
+        switch (value.type()) {
+        case Type::String:
+                return combine(seed, value.string_hash());
+        case Type::Symbol:
+                return combine(seed, value.symbol_id());
+        case Type::Pair: {
+                const LisppObject* cell = &value;
+                for (; cell->is_pair(); cell = &cell->cdr()) {
+                        seed = combine(seed, hash(cell->car()));
+                }
+                return combine(seed, hash(*cell));
+        }
+        case Type::List:
+                for (const auto& item : value.items()) {
+                        seed = combine(seed, hash(item));
+                }
+                return seed;
+        case Type::Map: {
+                // Sum the entries so the hash does not depend on their order.
+                size_t sum = 0;
+                value.map().for_each([&](const LisppObject& key,
+                                         const LisppObject& entry) {
+                        sum += combine(hash(key), hash(entry));
+                });
+                return combine(seed, sum);
+        }
+        case Type::F64Vec:
+                for (size_t i = 0; i < value.f64vec().size(); i++) {
+                        double number = value.f64vec()[i];
+                        seed = combine(seed, std::hash<double>{}(
+                                                 number == 0.0 ? 0.0 : number));
+                }
+                return seed;
+        case Type::Bytes: {
+                const auto& bytes = value.bytes();
+                auto* chars = reinterpret_cast<const char*>(bytes.data());
+                return combine(seed, std::hash<std::string_view>{}(
+                                         {chars, bytes.size()}));
+        }
+        case Type::SortedMap:
+                value.sorted_map().for_each([&](const LisppObject& key,
+                                                const LisppObject& entry) {
+                        seed = combine(seed, combine(hash(key), hash(entry)));
+                });
+                return seed;
+        default:
+                return seed;
+        }
+}
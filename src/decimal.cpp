@@ -0,0 +1,207 @@
+#include "decimal.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace decimal;
+using bignum::BigInt;
+
+namespace {
+
+BigInt pow10(uint32_t n)
+{
+        static const BigInt ten{10};
+        BigInt power{1};
+        BigInt base{ten};
+        // Square-and-multiply keeps large scales cheap.
+        for (; n > 0; n >>= 1) {
+                if (n & 1) {
+                        power = power * base;
+                }
+                if (n > 1) {
+                        base = base * base;
+                }
+        }
+        return power;
+}
+
+BigInt abs(const BigInt& value)
+{
+        return value.is_negative() ? -value : value;
+}
+
+bool is_odd(const BigInt& value)
+{
+        return !value.is_zero() && (value.magnitude().front() & 1) != 0;
+}
+
+// `value`'s unscaled part at a larger `scale`.
+BigInt widen(const Decimal& value, uint32_t scale)
+{
+        return value.unscaled * pow10(scale - value.scale);
+}
+
+} // namespace
+
+std::optional<Rounding> decimal::rounding_from_string(std::string_view name)
+{
+        if (name == "half-even") {
+                return Rounding::half_even;
+        }
+        if (name == "half-up") {
+                return Rounding::half_up;
+        }
+        if (name == "half-down") {
+                return Rounding::half_down;
+        }
+        if (name == "down") {
+                return Rounding::down;
+        }
+        if (name == "up") {
+                return Rounding::up;
+        }
+        if (name == "floor") {
+                return Rounding::floor;
+        }
+        if (name == "ceiling") {
+                return Rounding::ceiling;
+        }
+        return std::nullopt;
+}
+
+std::optional<Decimal> decimal::from_string(std::string_view text)
+{
+        std::string digits;
+        uint32_t scale = 0;
+        bool point = false;
+        for (size_t i = 0; i < text.size(); i++) {
+                char c = text[i];
+                if (c == '-' && i == 0) {
+                        digits += c;
+                }
+                else if (c == '.' && !point) {
+                        point = true;
+                }
+                else if (c >= '0' && c <= '9') {
+                        digits += c;
+                        scale += point ? 1 : 0;
+                }
+                else {
+                        return std::nullopt;
+                }
+        }
+        auto unscaled = BigInt::from_string(digits);
+        if (!unscaled) {
+                return std::nullopt;
+        }
+        return Decimal{std::move(*unscaled), scale};
+}
+
+std::string decimal::to_string(const Decimal& value)
+{
+        std::string digits = abs(value.unscaled).to_string();
+        if (value.scale > 0) {
+                if (digits.size() <= value.scale) {
+                        digits.insert(0, value.scale - digits.size() + 1, '0');
+                }
+                digits.insert(digits.size() - value.scale, 1, '.');
+        }
+        return value.unscaled.is_negative() ? "-" + digits : digits;
+}
+
+double decimal::to_double(const Decimal& value)
+{
+        // Going through the text gives the correctly rounded double.
+        return std::strtod(to_string(value).c_str(), nullptr);
+}
+
+Decimal decimal::add(const Decimal& a, const Decimal& b)
+{
+        uint32_t scale = std::max(a.scale, b.scale);
+        return Decimal{widen(a, scale) + widen(b, scale), scale};
+}
+
+Decimal decimal::sub(const Decimal& a, const Decimal& b)
+{
+        uint32_t scale = std::max(a.scale, b.scale);
+        return Decimal{widen(a, scale) - widen(b, scale), scale};
+}
+
+Decimal decimal::mul(const Decimal& a, const Decimal& b)
+{
+        return Decimal{a.unscaled * b.unscaled, a.scale + b.scale};
+}
+
+Decimal decimal::div(const Decimal& a, const Decimal& b, uint32_t scale,
+                     Rounding mode)
+{
+        if (b.unscaled.is_zero()) {
+                throw std::runtime_error("\n;Infinity. Division by zero.\n");
+        }
+        // a / b = (a.unscaled / b.unscaled) * 10^(b.scale - a.scale), so
+        // shift whichever side keeps the quotient at `scale`.
+        int64_t shift = int64_t{scale} + b.scale - a.scale;
+        BigInt n = a.unscaled;
+        BigInt d = b.unscaled;
+        if (shift >= 0) {
+                n = n * pow10(static_cast<uint32_t>(shift));
+        }
+        else {
+                d = d * pow10(static_cast<uint32_t>(-shift));
+        }
+        return Decimal{round_quotient(n, d, mode), scale};
+}
+
+Decimal decimal::rescale(const Decimal& value, uint32_t scale, Rounding mode)
+{
+        if (scale >= value.scale) {
+                return Decimal{widen(value, scale), scale};
+        }
+        return Decimal{round_quotient(value.unscaled,
+                                      pow10(value.scale - scale), mode),
+                       scale};
+}
+
+int decimal::compare(const Decimal& a, const Decimal& b)
+{
+        uint32_t scale = std::max(a.scale, b.scale);
+        return bignum::compare(widen(a, scale), widen(b, scale));
+}
+
+bool decimal::round_away(Rounding mode, bool negative, int half, bool odd)
+{
+        switch (mode) {
+        case Rounding::half_even:
+                return half > 0 || (half == 0 && odd);
+        case Rounding::half_up:
+                return half >= 0;
+        case Rounding::half_down:
+                return half > 0;
+        case Rounding::down:
+                return false;
+        case Rounding::up:
+                return true;
+        case Rounding::floor:
+                return negative;
+        case Rounding::ceiling:
+                return !negative;
+        }
+        return false;
+}
+
+BigInt decimal::round_quotient(const BigInt& n, const BigInt& d,
+                               Rounding mode)
+{
+        BigInt quotient, remainder;
+        BigInt::divmod(n, d, quotient, remainder);
+        if (remainder.is_zero()) {
+                return quotient;
+        }
+        bool negative = n.is_negative() != d.is_negative();
+        int half = bignum::compare(abs(remainder + remainder), abs(d));
+        if (round_away(mode, negative, half, is_odd(quotient))) {
+                quotient = quotient + BigInt{negative ? -1 : 1};
+        }
+        return quotient;
+}
@@ -1,31 +1,34 @@
 #include "evaluator.h"
 
+#include "gc.h"
+#include "profiler.h"
+
 using namespace type;
 
 namespace {
 
 LisppObject eval_symbol(const LisppObject& ast, Frame& frame)
 {
-        return frame.lookup(ast.symbol);
+        return frame.lookup(ast.symbol_id());
 }
 
-LisppObject eval_list(const LisppObject& ast, Frame& frame)
+// Evaluates each element of `list` into inline argument storage, so short
+// call forms evaluate without allocating.
+Arguments eval_list(const List& list, Frame& frame)
 {
-        auto list = LisppObject::create_list({});
-        for (const auto& item : ast.items) {
-                auto value = evaluator::eval(item, frame);
-                list.items.push_back(value);
+        Arguments items;
+        items.reserve(list.size());
+        for (const auto& item : list) {
+                items.push_back(evaluator::eval(item, frame));
         }
-        return list;
+        return items;
 }
 
 LisppObject eval_ast(const LisppObject& ast, Frame& frame)
 {
-        switch (ast.type) {
+        switch (ast.type()) {
         case Type::Symbol:
                 return eval_symbol(ast, frame);
-        case Type::List:
-                return eval_list(ast, frame);
         default:
                 return ast;
         }
@@ -36,7 +39,7 @@ LisppObject eval_definition(const LisppObject& ast, Frame& frame)
         LisppObject name = syntax::definition_name(ast);
         LisppObject value_arg = syntax::definition_value(ast);
         LisppObject value = evaluator::eval(value_arg, frame);
-        frame.set(name.symbol, value);
+        frame.set(name.symbol_id(), value);
         return value;
 }
 
@@ -45,22 +48,22 @@ LisppObject eval_assignment(const LisppObject& ast, Frame& frame)
         LisppObject name = syntax::variable_name(ast);
         LisppObject update_arg = syntax::variable_update(ast);
         LisppObject update = evaluator::eval(update_arg, frame);
-        frame.set(name.symbol, update);
+        frame.set(name.symbol_id(), update);
         return update;
 }
 
 LisppObject eval_local_assignment(const LisppObject& ast, Frame& frame)
 {
-        Frame local{std::make_shared<Frame>(frame)};
+        auto local = Frame::create(Ref<Frame>{&frame});
         std::vector<LisppObject> vars{syntax::local_variables(ast)};
         for (auto it = vars.begin(); it != vars.end(); it += 2) {
                 auto name = *it;
                 auto binding = *(it + 1);
-                auto value = evaluator::eval(binding, local);
-                local.set(name.symbol, value);
+                auto value = evaluator::eval(binding, *local);
+                local->set(name.symbol_id(), value);
         }
         LisppObject body = syntax::local_body(ast);
-        return evaluator::eval(body, local);
+        return evaluator::eval(body, *local);
 }
 
 LisppObject eval_if(const LisppObject& ast, Frame& frame)
@@ -79,24 +82,25 @@ LisppObject eval_if(const LisppObject& ast, Frame& frame)
 
 LisppObject eval_function(const LisppObject& ast, Frame& frame)
 {
-        std::vector<LisppObject> parameters{syntax::function_parameters(ast)};
-        LisppObject body = syntax::function_body(ast);
-        auto fn = [parameters, body,
-                   &frame](std::vector<LisppObject> arguments) {
-                Frame local{std::make_shared<Frame>(frame)};
-                if (arguments.size() != parameters.size()) {
-                        throw exception::invalid_arg_size("The procedure",
-                                                          arguments.size(),
-                                                          parameters.size());
-                }
-                for (size_t i = 0; i < parameters.size(); i++) {
-                        auto parameter = parameters.at(i);
-                        auto argument = arguments.at(i);
-                        local.set(parameter.symbol, argument);
-                }
-                return evaluator::eval(body, local);
-        };
-        return LisppObject::create_function(fn);
+        Closure closure;
+        for (const auto& parameter : syntax::function_parameters(ast)) {
+                closure.parameters.push_back(parameter.symbol_id());
+        }
+        closure.body = syntax::function_body(ast);
+        closure.env = Ref<HeapObject>{&frame};
+        return LisppObject::create_closure(std::move(closure));
+}
+
+// (frame-memory) -> LisppObject.Integer: the bytes held by the frame it is
+// evaluated in and its parents.
+LisppObject eval_frame_memory(const LisppObject& ast, Frame& frame)
+{
+        if (ast.items().size() != 1) {
+                throw exception::ill_form_error("(frame-memory) takes no "
+                                                "arguments");
+        }
+        return LisppObject::create_integer(
+            static_cast<int64_t>(frame.memory()));
 }
 
 bool is_self_evaluating(const LisppObject& ast)
@@ -112,39 +116,60 @@ LisppObject evaluator::eval(const LisppObject& ast, Frame& frame)
                 return eval_ast(ast, frame);
         }
 
-        auto list = ast.items;
+        const auto& list = ast.items();
         if (list.empty()) {
                 return ast;
         }
 
-        auto symbol = list.front().symbol;
-        if (syntax::is_definition(symbol)) {
-                return eval_definition(ast, frame);
-        }
-        else if (syntax::is_assigment(symbol)) {
-                return eval_assignment(ast, frame);
+        const auto& head = list.front();
+        if (head.is_symbol()) {
+                auto symbol = head.symbol_id();
+                if (syntax::is_definition(symbol)) {
+                        return eval_definition(ast, frame);
+                }
+                else if (syntax::is_assigment(symbol)) {
+                        return eval_assignment(ast, frame);
+                }
+                else if (syntax::is_local_assignment(symbol)) {
+                        return eval_local_assignment(ast, frame);
+                }
+                else if (syntax::is_if(symbol)) {
+                        return eval_if(ast, frame);
+                }
+                else if (syntax::is_function(symbol)) {
+                        return eval_function(ast, frame);
+                }
+                else if (syntax::is_frame_memory(symbol)) {
+                        return eval_frame_memory(ast, frame);
+                }
         }
-        else if (syntax::is_local_assignment(symbol)) {
-                return eval_local_assignment(ast, frame);
+
+        LisppObject function = evaluator::eval(syntax::apply_function(ast), frame);
+        Arguments arguments = eval_list(syntax::apply_arguments(ast), frame);
+        static const auto anonymous = symbols::intern("fn");
+        profiler::Call call{head.is_symbol() ? head.symbol_id() : anonymous};
+        return evaluator::apply(function, std::move(arguments));
+}
+
+LisppObject evaluator::apply(const LisppObject& function, Arguments arguments)
+{
+        if (!function.is_function()) {
+                throw exception::ill_form_error("object is not callable");
         }
-        else if (syntax::is_if(symbol)) {
-                return eval_if(ast, frame);
+        // Every live cell is held by a counted reference here.
+        gc::maybe_collect();
+        if (function.is_builtin()) {
+                return function.builtin()(std::move(arguments));
         }
-        else if (syntax::is_function(symbol)) {
-                return eval_function(ast, frame);
+        const Closure& closure = function.closure();
+        if (arguments.size() != closure.parameters.size()) {
+                throw exception::invalid_arg_size(
+                    "The procedure", arguments.size(), closure.parameters.size());
         }
-        else {
-                LisppObject ast_value = eval_ast(ast, frame);
-                LisppObject function = syntax::apply_function(ast_value);
-                std::vector<LisppObject> arguments{
-                    syntax::apply_arguments(ast_value)};
-                return evaluator::apply(function, arguments);
+        auto* env = static_cast<Frame*>(closure.env.get());
+        auto local = Frame::create(Ref<Frame>{env});
+        for (size_t i = 0; i < closure.parameters.size(); i++) {
+                local->set(closure.parameters[i], std::move(arguments[i]));
         }
-}
-
-LisppObject evaluator::apply(const LisppObject& function,
-                             const std::vector<LisppObject>& arguments)
-{
-        auto result = function.lambda(arguments);
-        return result;
+        return evaluator::eval(closure.body, *local);
 }
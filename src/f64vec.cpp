@@ -0,0 +1,62 @@
+#include "f64vec.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace type;
+
+F64Buffer* F64Buffer::create(size_t size)
+{
+        void* memory = allocate_cell(sizeof(F64Buffer) + size * sizeof(double));
+        auto* buffer = ::new (memory) F64Buffer;
+        buffer->size = size;
+        return buffer;
+}
+
+F64Vec::F64Vec(size_t size) : buffer{F64Buffer::create(size)}, length{size}
+{
+        std::fill_n(buffer->values(), size, 0.0);
+}
+
+double* F64Vec::mutable_data()
+{
+        if (buffer && !buffer.unique()) {
+                Ref<F64Buffer> copy{F64Buffer::create(length)};
+                std::copy_n(data(), length, copy->values());
+                buffer = std::move(copy);
+                offset = 0;
+        }
+        return buffer ? buffer->values() + offset : nullptr;
+}
+
+double F64Vec::at(size_t index) const
+{
+        if (index >= length) {
+                throw std::runtime_error("\n;Index out of range: " +
+                                         std::to_string(index) + ".\n");
+        }
+        return (*this)[index];
+}
+
+void F64Vec::set(size_t index, double value)
+{
+        if (index >= length) {
+                throw std::runtime_error("\n;Index out of range: " +
+                                         std::to_string(index) + ".\n");
+        }
+        mutable_data()[index] = value;
+}
+
+F64Vec F64Vec::slice(size_t start, size_t end) const
+{
+        if (start > end || end > length) {
+                throw std::runtime_error("\n;Invalid slice [" +
+                                         std::to_string(start) + ", " +
+                                         std::to_string(end) + ").\n");
+        }
+        F64Vec slice{*this};
+        slice.offset += start;
+        slice.length = end - start;
+        return slice;
+}
@@ -0,0 +1,90 @@
+#include "footprint.h"
+
+#include <unordered_map>
+#include <vector>
+
+using namespace type;
+
+namespace {
+
+// Queues the cells a cell references. Walks use an explicit stack, since
+// lists, cons chains and ropes can be arbitrarily deep.
+struct Pending : CellVisitor {
+        void operator()(const HeapObject* cell) override
+        {
+                if (cell != nullptr) {
+                        cells.push_back(cell);
+                }
+        }
+
+        const HeapObject* pop()
+        {
+                const HeapObject* cell = cells.back();
+                cells.pop_back();
+                return cell;
+        }
+
+        bool empty() const { return cells.empty(); }
+
+        std::vector<const HeapObject*> cells;
+};
+
+} // namespace
+
+size_t footprint::reachable_size(const LisppObject& value, Seen& seen)
+{
+        Pending pending;
+        value.trace(pending);
+        size_t total = 0;
+        while (!pending.empty()) {
+                const HeapObject* cell = pending.pop();
+                if (seen.insert(cell).second) {
+                        total += cell->size_in_bytes();
+                        cell->trace(pending);
+                }
+        }
+        return total;
+}
+
+size_t footprint::deep_size(const LisppObject& value)
+{
+        Seen seen;
+        return sizeof(LisppObject) + reachable_size(value, seen);
+}
+
+size_t footprint::retained_size(const LisppObject& value)
+{
+        // Count the references each reachable cell receives from within the
+        // graph, counting `value` itself as one. A cell with more references
+        // than that is also held from outside, and so is everything below it.
+        std::unordered_map<const HeapObject*, size_t> inbound;
+        std::vector<const HeapObject*> cells;
+        Pending pending;
+        value.trace(pending);
+        while (!pending.empty()) {
+                const HeapObject* cell = pending.pop();
+                if (inbound[cell]++ == 0) {
+                        cells.push_back(cell);
+                        cell->trace(pending);
+                }
+        }
+        Seen shared;
+        for (const HeapObject* cell : cells) {
+                if (inbound[cell] < cell->refcount) {
+                        pending(cell);
+                }
+        }
+        while (!pending.empty()) {
+                const HeapObject* cell = pending.pop();
+                if (shared.insert(cell).second) {
+                        cell->trace(pending);
+                }
+        }
+        size_t total = 0;
+        for (const HeapObject* cell : cells) {
+                if (shared.count(cell) == 0) {
+                        total += cell->size_in_bytes();
+                }
+        }
+        return total;
+}
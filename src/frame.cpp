@@ -1,51 +1,151 @@
 #include "frame.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "footprint.h"
+#include "gc.h"
+
 using namespace type;
 
-void Frame::set(const std::string& sym, const LisppObject& value)
+Frame::Frame(const Frame& other)
+    : HeapObject(other), parent(other.parent), bindings(other.bindings),
+      index(other.index ? std::make_unique<Index>(*other.index) : nullptr)
+{
+        pin();
+}
+
+Ref<Frame> Frame::create(Ref<Frame> parent)
+{
+        auto* frame = new Frame{std::move(parent)};
+        frame->refcount = 0;
+        frame->pinned = false;
+        frame->cyclic = true;
+        return Ref<Frame>{frame};
+}
+
+void Frame::set(symbols::SymbolId sym, const LisppObject& value)
+{
+        if (LisppObject* binding = find(sym)) {
+                if (traced) {
+                        gc::shade(*binding);
+                }
+                *binding = value;
+                return;
+        }
+        bindings.push_back(Binding{sym, value});
+        if (index) {
+                index->emplace(sym, static_cast<uint32_t>(bindings.size() - 1));
+        }
+        else if (bindings.size() > index_threshold) {
+                index = std::make_unique<Index>();
+                for (size_t i = 0; i < bindings.size(); i++) {
+                        index->emplace(bindings[i].symbol,
+                                       static_cast<uint32_t>(i));
+                }
+        }
+}
+
+LisppObject Frame::lookup(symbols::SymbolId sym) const
 {
-        symbols[sym] = value;
+        for (const Frame* frame = this; frame != nullptr;
+             frame = frame->parent.get()) {
+                if (const LisppObject* value = frame->find(sym)) {
+                        return *value;
+                }
+        }
+        throw exception::unbound_symbol_error(symbols::name(sym));
 }
 
-LisppObject Frame::lookup(const std::string& sym) const
+const LisppObject* Frame::find(symbols::SymbolId sym) const
 {
-        std::optional<Frame> opt{find(sym)};
-        if (opt.has_value()) {
-                auto frame = opt.value();
-                return frame.symbols[sym];
+        if (index) {
+                auto it = index->find(sym);
+                return it != index->end() ? &bindings[it->second].value
+                                          : nullptr;
+        }
+        for (const auto& binding : bindings) {
+                if (binding.symbol == sym) {
+                        return &binding.value;
+                }
+        }
+        return nullptr;
+}
+
+void Frame::print_symbols(bool sizes) const
+{
+        if (!sizes) {
+                for (const auto& [sym, _] : bindings) {
+                        std::cout << symbols::name(sym) << std::endl;
+                }
+                return;
+        }
+        std::vector<std::pair<size_t, symbols::SymbolId>> retained;
+        for (const auto& [sym, value] : bindings) {
+                retained.emplace_back(footprint::retained_size(value), sym);
         }
-        else {
-                throw exception::unbound_symbol_error(sym);
+        std::sort(retained.rbegin(), retained.rend());
+        for (const auto& [bytes, sym] : retained) {
+                std::cout << symbols::name(sym) << " " << bytes << std::endl;
         }
 }
 
-std::optional<Frame> Frame::find(const std::string& sym) const
+size_t Frame::size_in_bytes() const
 {
-        bool found = symbols.find(sym) != symbols.end();
-        if (found) {
-                return *this;
+        size_t total = sizeof(Frame);
+        if (bindings.capacity() > inline_bindings) {
+                total += bindings.capacity() * sizeof(Binding);
         }
-        else if (parent != nullptr) {
-                return parent->find(sym);
+        if (index) {
+                // An index node holds the link to the next node and the entry.
+                constexpr size_t entry_bytes =
+                    sizeof(void*) + sizeof(Index::value_type);
+                total += sizeof(Index) + index->bucket_count() * sizeof(void*) +
+                         index->size() * entry_bytes;
         }
-        else {
-                return std::nullopt;
+        return total;
+}
+
+void Frame::trace(CellVisitor& visit) const
+{
+        visit(parent.get());
+        for (const auto& [_, value] : bindings) {
+                value.trace(visit);
         }
 }
 
-void Frame::print_symbols() const
+void Frame::drop_references()
 {
-        for (const auto& [sym, _] : symbols) {
-                std::cout << sym << std::endl;
+        bindings.clear();
+        index.reset();
+        parent = Ref<Frame>{};
+}
+
+size_t Frame::memory() const
+{
+        // Closures lead back into the chain; count each frame here, once.
+        footprint::Seen seen;
+        for (const Frame* frame = this; frame != nullptr;
+             frame = frame->parent.get()) {
+                seen.insert(frame);
+        }
+        size_t total = 0;
+        for (const Frame* frame = this; frame != nullptr;
+             frame = frame->parent.get()) {
+                total += frame->size_in_bytes();
+                for (const auto& [_, value] : frame->bindings) {
+                        total += footprint::reachable_size(value, seen);
+                }
         }
+        return total;
 }
 
 Frame Frame::global()
 {
         Frame global;
         for (const auto& [sym, op] : operators::core) {
-                auto function = LisppObject::create_function(op);
-                global.set(sym, function);
+                auto function = LisppObject::create_builtin(op);
+                global.set(symbols::intern(sym), function);
         }
         return global;
 }
@@ -0,0 +1,331 @@
+#include "gc.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace type;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Collecting only pays off once there is a batch of candidates; when most
+// of a batch turns out to be live, wait for a larger one.
+constexpr size_t base_threshold = 10000;
+constexpr uint64_t default_pause_us = 1000;
+// A budget no collection reaches: a day.
+constexpr uint64_t unlimited_us = 86'400'000'000;
+
+std::unordered_set<HeapObject*> candidates;
+size_t threshold = base_threshold;
+// Cells reached by the last collection, to size the next one's tables up
+// front: growing a large table mid-collection would stall a slice.
+size_t last_cells = 0;
+gc::Stats totals;
+
+uint64_t pause_budget()
+{
+        static const uint64_t budget = [] {
+                const char* setting = std::getenv("LISPP_GC_PAUSE_US");
+                return setting != nullptr ? std::strtoull(setting, nullptr, 10)
+                                          : default_pause_us;
+        }();
+        return budget;
+}
+
+enum class Phase { idle, scan, classify, mark, sweep, release };
+
+// The collection in progress. Every cell it reaches is held until it
+// finishes, and all but pinned ones are marked `traced`.
+struct Collection {
+        Phase phase = Phase::idle;
+        // The candidates still to add to the graph.
+        std::unordered_set<HeapObject*> seeds;
+        // Each reached cell, with the references it receives from within
+        // the graph. Pinned cells are not entered: they are live, and so is
+        // everything they reach.
+        std::unordered_map<HeapObject*, size_t> inbound;
+        // Reached cells in order, starting with the candidates.
+        std::vector<HeapObject*> cells;
+        size_t roots = 0;
+        std::vector<HeapObject*> to_scan;
+        // Cells found live, and those whose references are still to mark.
+        std::unordered_set<HeapObject*> live;
+        std::vector<HeapObject*> to_mark;
+        // The position of the walk over `cells` in the later phases.
+        size_t next = 0;
+        size_t survivors = 0;
+};
+
+Collection current;
+Clock::time_point last_slice_end;
+
+void reach(HeapObject* cell)
+{
+        retain(cell);
+        cell->traced = !cell->pinned;
+        current.cells.push_back(cell);
+        current.to_scan.push_back(cell);
+}
+
+struct Scan : CellVisitor {
+        void operator()(const HeapObject* cell) override
+        {
+                if (cell == nullptr) {
+                        return;
+                }
+                auto* mutable_cell = const_cast<HeapObject*>(cell);
+                auto [entry, first] = current.inbound.try_emplace(mutable_cell);
+                entry->second++;
+                if (first) {
+                        reach(mutable_cell);
+                }
+        }
+};
+
+struct Mark : CellVisitor {
+        void operator()(const HeapObject* cell) override
+        {
+                if (cell == nullptr) {
+                        return;
+                }
+                auto* mutable_cell = const_cast<HeapObject*>(cell);
+                if (mutable_cell->traced &&
+                    current.live.insert(mutable_cell).second) {
+                        current.to_mark.push_back(mutable_cell);
+                }
+        }
+};
+
+// Whether `cell` is referenced from outside the graph, not counting the
+// collection's own hold on it.
+bool held_outside(HeapObject* cell)
+{
+        return cell->pinned || cell->refcount - 1 > current.inbound[cell];
+}
+
+// Drops the collection's hold on a cell. A live cell is not buffered again
+// for it: losing the hold says nothing about its reachability.
+void release_hold(HeapObject* cell)
+{
+        cell->traced = false;
+        if (--cell->refcount == 0) {
+                delete cell;
+        }
+}
+
+void record_pause(Clock::time_point start)
+{
+        last_slice_end = Clock::now();
+        uint64_t pause = std::chrono::duration_cast<std::chrono::microseconds>(
+                             last_slice_end - start)
+                             .count();
+        size_t bucket = 0;
+        while (bucket + 1 < totals.pauses.size() && pause >= (1ull << bucket)) {
+                bucket++;
+        }
+        totals.pauses[bucket]++;
+        totals.slices++;
+        totals.last_pause_us = pause;
+        totals.max_pause_us = std::max(totals.max_pause_us, pause);
+        totals.total_pause_us += pause;
+}
+
+// Moves to the next phase, restarting the walk over the reached cells.
+void advance(Phase phase)
+{
+        current.phase = phase;
+        current.next = 0;
+}
+
+// Does one unit of the current phase's work, which touches one cell.
+// Returns false once the collection is done.
+//
+// A cell counted as held only from within the graph cannot gain a
+// reference from outside without the evaluator finding it through the
+// graph: either through a live cell, which marks it in turn, or through a
+// reference that has since been dropped, which the write barrier shades.
+// So each cell is classified once, and the phases need not run atomically.
+bool work()
+{
+        switch (current.phase) {
+        case Phase::scan:
+                if (!current.seeds.empty()) {
+                        HeapObject* cell = *current.seeds.begin();
+                        current.seeds.erase(current.seeds.begin());
+                        cell->buffered = false;
+                        current.inbound.emplace(cell, 0);
+                        current.roots++;
+                        reach(cell);
+                }
+                else if (current.to_scan.empty()) {
+                        advance(Phase::classify);
+                }
+                else {
+                        HeapObject* cell = current.to_scan.back();
+                        current.to_scan.pop_back();
+                        if (!cell->pinned) {
+                                Scan scan;
+                                cell->trace(scan);
+                        }
+                }
+                return true;
+        case Phase::classify:
+                if (current.next == current.cells.size()) {
+                        advance(Phase::mark);
+                }
+                else {
+                        HeapObject* cell = current.cells[current.next++];
+                        if (held_outside(cell) &&
+                            current.live.insert(cell).second) {
+                                current.to_mark.push_back(cell);
+                        }
+                }
+                return true;
+        case Phase::mark:
+                if (current.to_mark.empty()) {
+                        advance(Phase::sweep);
+                }
+                else {
+                        HeapObject* cell = current.to_mark.back();
+                        current.to_mark.pop_back();
+                        if (!cell->pinned) {
+                                Mark mark;
+                                cell->trace(mark);
+                        }
+                }
+                return true;
+        case Phase::sweep:
+                // Every garbage cell is still held, so emptying the cyclic
+                // ones frees nothing until the holds are dropped.
+                if (current.next == current.cells.size()) {
+                        advance(Phase::release);
+                }
+                else {
+                        size_t index = current.next++;
+                        HeapObject* cell = current.cells[index];
+                        bool live = current.live.count(cell) != 0;
+                        if (index < current.roots && live) {
+                                current.survivors++;
+                        }
+                        if (cell->cyclic && !live) {
+                                cell->drop_references();
+                        }
+                }
+                return true;
+        case Phase::release:
+                if (current.next == current.cells.size()) {
+                        threshold =
+                            std::max(base_threshold, 2 * current.survivors);
+                        last_cells = current.cells.size();
+                        totals.collections++;
+                        current = Collection{};
+                        return false;
+                }
+                else {
+                        // Emptying the tables as we go leaves nothing large
+                        // to free at the end.
+                        HeapObject* cell = current.cells[current.next++];
+                        current.inbound.erase(cell);
+                        current.live.erase(cell);
+                        size_t cells_before = heap_usage.cells;
+                        release_hold(cell);
+                        totals.reclaimed_cells +=
+                            cells_before - heap_usage.cells;
+                }
+                return true;
+        case Phase::idle:
+                break;
+        }
+        return false;
+}
+
+} // namespace
+
+void gc::buffer(HeapObject* cell)
+{
+        cell->buffered = true;
+        candidates.insert(cell);
+}
+
+void gc::unbuffer(HeapObject* cell)
+{
+        cell->buffered = false;
+        if (candidates.erase(cell) == 0) {
+                current.seeds.erase(cell);
+        }
+}
+
+void gc::start()
+{
+        if (current.phase != Phase::idle || candidates.empty()) {
+                return;
+        }
+        current.phase = Phase::scan;
+        current.seeds.swap(candidates);
+        current.inbound.reserve(last_cells);
+        current.live.reserve(last_cells);
+        current.cells.reserve(last_cells);
+}
+
+bool gc::step(uint64_t budget_us)
+{
+        if (current.phase == Phase::idle) {
+                return true;
+        }
+        auto start = Clock::now();
+        auto deadline = start + std::chrono::microseconds(budget_us);
+        bool more = work();
+        while (more && Clock::now() < deadline) {
+                more = work();
+        }
+        record_pause(start);
+        return !more;
+}
+
+size_t gc::collect()
+{
+        uint64_t before = totals.reclaimed_cells;
+        step(unlimited_us);
+        start();
+        step(unlimited_us);
+        return totals.reclaimed_cells - before;
+}
+
+void gc::maybe_collect()
+{
+        if (current.phase == Phase::idle) {
+                if (candidates.size() < threshold) {
+                        return;
+                }
+                start();
+        }
+        // Leave evaluation at least as much time as the collector takes.
+        else if (Clock::now() - last_slice_end <
+                 std::chrono::microseconds(pause_budget())) {
+                return;
+        }
+        step(pause_budget());
+}
+
+void gc::shade(const LisppObject& value)
+{
+        Mark mark;
+        value.trace(mark);
+}
+
+void gc::shade_references(const HeapObject& cell)
+{
+        Mark mark;
+        cell.trace(mark);
+}
+
+const gc::Stats& gc::stats()
+{
+        totals.candidates = candidates.size();
+        return totals;
+}
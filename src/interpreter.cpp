@@ -12,22 +12,45 @@ std::string interpreter::getinput()
 
 std::string interpreter::rep(const std::string& line, Frame& frame)
 {
+        // Scratch for this form, freed once it has been printed.
+        arena::Scope scope;
         auto expression = Reader::read(line);
         auto value = evaluator::eval(expression, frame);
         auto output = printer::print(value);
         return output;
 }
 
+std::string interpreter::rep(const std::string& line, Frame& frame,
+                             Budget& budget)
+{
+        type::HeapQuota quota{budget.heap_bytes, budget.peak_heap_bytes};
+        return rep(line, frame);
+}
+
 void interpreter::repl()
 {
         Frame global_frame{Frame::global()};
+        // Each form's heap quota, if any.
+        Budget budget;
+        if (const char* setting = std::getenv("LISPP_HEAP_QUOTA")) {
+                budget.heap_bytes = std::strtoull(setting, nullptr, 10);
+        }
+        // Where to write the allocation profile on exit, if anywhere.
+        const char* profile = std::getenv("LISPP_ALLOC_PROFILE");
+        if (profile != nullptr) {
+                const char* setting = std::getenv("LISPP_ALLOC_SAMPLE_BYTES");
+                profiler::start(setting != nullptr
+                                    ? std::strtoull(setting, nullptr, 10)
+                                    : profiler::default_sample_bytes);
+        }
         printer::welcome();
         std::string input;
         while (true) {
                 printer::prompt();
                 try {
                         input = interpreter::getinput();
-                        auto output = interpreter::rep(input, global_frame);
+                        auto output =
+                            interpreter::rep(input, global_frame, budget);
                         printer::format_print(output);
                 }
                 catch (exception::eof_input_error err) {
@@ -38,4 +61,7 @@ void interpreter::repl()
                         std::cout << err.what() << std::endl;
                 }
         }
+        if (profile != nullptr) {
+                profiler::write(profile);
+        }
 }
@@ -0,0 +1,175 @@
+#include "list.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace type;
+
+struct type::VectorBranch : HeapObject {
+        size_t size_in_bytes() const override { return sizeof(VectorBranch); }
+
+        void trace(CellVisitor& visit) const override
+        {
+                for (const auto& child : children) {
+                        visit(child.get());
+                }
+        }
+
+        Ref<HeapObject> children[List::width];
+};
+
+namespace {
+
+VectorBranch* as_branch(HeapObject* node)
+{
+        return static_cast<VectorBranch*>(node);
+}
+
+// Returns the branch in `slot` for mutation, first replacing it with a fresh
+// or copied branch unless it is owned exclusively.
+VectorBranch* unique_branch(Ref<HeapObject>& slot)
+{
+        if (!slot) {
+                slot = Ref<HeapObject>{new VectorBranch};
+        }
+        else if (!slot.unique()) {
+                slot = Ref<HeapObject>{new VectorBranch{*as_branch(slot.get())}};
+        }
+        return as_branch(slot.get());
+}
+
+Ref<VectorLeaf> copy_leaf(const VectorLeaf& leaf, uint32_t capacity)
+{
+        Ref<VectorLeaf> copy{VectorLeaf::create(capacity)};
+        for (uint32_t i = 0; i < leaf.count; i++) {
+                new (&copy->values()[i]) LisppObject{leaf.values()[i]};
+        }
+        copy->count = leaf.count;
+        return copy;
+}
+
+} // namespace
+
+VectorLeaf* VectorLeaf::create(uint32_t capacity)
+{
+        void* memory =
+            allocate_cell(sizeof(VectorLeaf) + capacity * sizeof(LisppObject));
+        auto* leaf = ::new (memory) VectorLeaf;
+        leaf->capacity = capacity;
+        return leaf;
+}
+
+VectorLeaf::~VectorLeaf()
+{
+        for (uint32_t i = 0; i < count; i++) {
+                values()[i].~LisppObject();
+        }
+}
+
+// Releases the chain of cells behind this one iteratively, so dropping a long
+// cons list does not recurse once per cell.
+PairCell::~PairCell()
+{
+        LisppObject next = std::move(cdr);
+        while (next.is_pair() && next.data.heap->refcount == 1) {
+                auto* pair = static_cast<PairCell*>(next.data.heap);
+                LisppObject after = std::move(pair->cdr);
+                next = std::move(after);
+        }
+}
+
+List::List(const LisppObject* items, size_t size)
+{
+        for (size_t i = 0; i < size; i++) {
+                if (count == tail_offset() + width) {
+                        push_tail(shift, root);
+                }
+                if (!tail || tail->count == width) {
+                        // Size each fresh tail for what remains, so short
+                        // lists take no more room than they need.
+                        auto remaining = std::min<size_t>(width, size - i);
+                        tail = Ref<VectorLeaf>{
+                            VectorLeaf::create(static_cast<uint32_t>(remaining))};
+                }
+                new (&tail->values()[tail->count++]) LisppObject{items[i]};
+                count++;
+        }
+}
+
+const LisppObject& List::at(size_t index) const
+{
+        if (index >= size()) {
+                throw std::runtime_error("\n;Index out of range: " +
+                                        std::to_string(index) + ".\n");
+        }
+        return (*this)[index];
+}
+
+List List::rest() const
+{
+        List rest{*this};
+        if (!rest.empty()) {
+                rest.offset++;
+        }
+        return rest;
+}
+
+List List::conj(LisppObject value) const
+{
+        List list{*this};
+        list.push_back(std::move(value));
+        return list;
+}
+
+void List::push_back(LisppObject value)
+{
+        uint32_t tail_count = static_cast<uint32_t>(count - tail_offset());
+        if (tail_count == width) {
+                // The tail is full: move it into the trie and start a new one.
+                push_tail(shift, root);
+                tail = Ref<VectorLeaf>{VectorLeaf::create(width)};
+        }
+        else if (!tail) {
+                tail = Ref<VectorLeaf>{VectorLeaf::create(1)};
+        }
+        else if (!tail.unique() || tail->count == tail->capacity) {
+                auto capacity = std::min(width, std::max(tail_count + 1,
+                                                         tail_count * 2));
+                tail = copy_leaf(*tail, capacity);
+        }
+        new (&tail->values()[tail->count++]) LisppObject{std::move(value)};
+        count++;
+}
+
+const VectorLeaf* List::leaf_for(size_t index) const
+{
+        if (index >= tail_offset()) {
+                return tail.get();
+        }
+        HeapObject* node = root.get();
+        for (unsigned level = shift; level > 0; level -= bits) {
+                node = as_branch(node)->children[(index >> level) & mask].get();
+        }
+        return static_cast<const VectorLeaf*>(node);
+}
+
+// Moves the full tail into the trie below `slot`, growing a new root level
+// when the trie is full. Called with `count` still covering the tail.
+void List::push_tail(unsigned level, Ref<HeapObject>& slot)
+{
+        if (&slot == &root && (count >> bits) > (size_t{1} << shift)) {
+                Ref<HeapObject> grown{new VectorBranch};
+                as_branch(grown.get())->children[0] = std::move(root);
+                root = std::move(grown);
+                shift += bits;
+                level = shift;
+        }
+        VectorBranch* node = unique_branch(slot);
+        auto& child = node->children[((count - 1) >> level) & mask];
+        if (level == bits) {
+                child = Ref<HeapObject>{tail.get()};
+        }
+        else {
+                push_tail(level - bits, child);
+        }
+}
@@ -0,0 +1,213 @@
+#include "map.h"
+
+#include "compare.h"
+
+using namespace type;
+
+namespace {
+
+constexpr unsigned hash_bits = 64;
+
+uint32_t fragment(size_t hash, unsigned shift)
+{
+        return static_cast<uint32_t>(hash >> shift) & Map::mask;
+}
+
+// Position of the entry for `bit` among the node's occupied slots.
+size_t position(const MapNode& node, uint32_t bit)
+{
+        return static_cast<size_t>(__builtin_popcount(node.bitmap & (bit - 1)));
+}
+
+// Returns the node in `slot` for mutation, first replacing it with a fresh
+// or copied node unless it is owned exclusively.
+MapNode* unique_node(Ref<MapNode>& slot)
+{
+        if (!slot) {
+                slot = Ref<MapNode>{new MapNode};
+        }
+        else if (!slot.unique()) {
+                slot = Ref<MapNode>{new MapNode{*slot}};
+        }
+        return slot.get();
+}
+
+// A node holding two entries whose hashes agree below `shift`.
+Ref<MapNode> split(unsigned shift, MapEntry first, MapEntry second)
+{
+        Ref<MapNode> node{new MapNode};
+        if (shift >= hash_bits) {
+                node->collision = true;
+                node->entries.push_back(std::move(first));
+                node->entries.push_back(std::move(second));
+                return node;
+        }
+        uint32_t f1 = fragment(first.hash, shift);
+        uint32_t f2 = fragment(second.hash, shift);
+        if (f1 == f2) {
+                node->bitmap = 1u << f1;
+                MapEntry entry;
+                entry.child = split(shift + Map::bits, std::move(first),
+                                    std::move(second));
+                node->entries.push_back(std::move(entry));
+        }
+        else {
+                node->bitmap = (1u << f1) | (1u << f2);
+                if (f2 < f1) {
+                        std::swap(first, second);
+                }
+                node->entries.push_back(std::move(first));
+                node->entries.push_back(std::move(second));
+        }
+        return node;
+}
+
+// Inserts below `slot`; returns whether the key was new.
+bool insert_node(Ref<MapNode>& slot, unsigned shift, MapEntry entry)
+{
+        MapNode* node = unique_node(slot);
+        if (node->collision) {
+                for (auto& existing : node->entries) {
+                        if (compare::equal(existing.key, entry.key)) {
+                                existing.value = std::move(entry.value);
+                                return false;
+                        }
+                }
+                node->entries.push_back(std::move(entry));
+                return true;
+        }
+        uint32_t bit = 1u << fragment(entry.hash, shift);
+        size_t pos = position(*node, bit);
+        if ((node->bitmap & bit) == 0) {
+                node->bitmap |= bit;
+                node->entries.insert(node->entries.begin() + pos,
+                                     std::move(entry));
+                return true;
+        }
+        MapEntry& existing = node->entries[pos];
+        if (existing.child) {
+                return insert_node(existing.child, shift + Map::bits,
+                                   std::move(entry));
+        }
+        if (existing.hash == entry.hash &&
+            compare::equal(existing.key, entry.key)) {
+                existing.value = std::move(entry.value);
+                return false;
+        }
+        MapEntry moved = std::move(existing);
+        existing = MapEntry{};
+        existing.child =
+            split(shift + Map::bits, std::move(moved), std::move(entry));
+        return true;
+}
+
+// Removes `key` below `slot`, which must contain it. Empties the slot when
+// its node becomes empty; a child left with a lone entry is collapsed into
+// its parent.
+void erase_node(Ref<MapNode>& slot, unsigned shift, size_t hash,
+                const LisppObject& key)
+{
+        MapNode* node = unique_node(slot);
+        if (node->collision) {
+                for (auto it = node->entries.begin(); it != node->entries.end();
+                     ++it) {
+                        if (compare::equal(it->key, key)) {
+                                node->entries.erase(it);
+                                break;
+                        }
+                }
+        }
+        else {
+                uint32_t bit = 1u << fragment(hash, shift);
+                size_t pos = position(*node, bit);
+                MapEntry& existing = node->entries[pos];
+                if (existing.child) {
+                        erase_node(existing.child, shift + Map::bits, hash, key);
+                        if (!existing.child) {
+                                node->bitmap &= ~bit;
+                                node->entries.erase(node->entries.begin() +
+                                                    pos);
+                        }
+                        else if (existing.child->entries.size() == 1 &&
+                                 !existing.child->entries[0].child) {
+                                // Hold the child's lone entry directly.
+                                MapEntry lone = existing.child->entries[0];
+                                existing = std::move(lone);
+                        }
+                }
+                else {
+                        node->bitmap &= ~bit;
+                        node->entries.erase(node->entries.begin() + pos);
+                }
+        }
+        if (node->entries.empty()) {
+                slot = Ref<MapNode>{};
+        }
+}
+
+} // namespace
+
+const LisppObject* Map::find(const LisppObject& key) const
+{
+        size_t hash = compare::hash(key);
+        const MapNode* node = root.get();
+        for (unsigned shift = 0; node != nullptr; shift += bits) {
+                if (node->collision) {
+                        for (const auto& entry : node->entries) {
+                                if (compare::equal(entry.key, key)) {
+                                        return &entry.value;
+                                }
+                        }
+                        return nullptr;
+                }
+                uint32_t bit = 1u << fragment(hash, shift);
+                if ((node->bitmap & bit) == 0) {
+                        return nullptr;
+                }
+                const MapEntry& entry = node->entries[position(*node, bit)];
+                if (entry.child) {
+                        node = entry.child.get();
+                }
+                else {
+                        return (entry.hash == hash &&
+                                compare::equal(entry.key, key))
+                                   ? &entry.value
+                                   : nullptr;
+                }
+        }
+        return nullptr;
+}
+
+Map Map::assoc(LisppObject key, LisppObject value) const
+{
+        Map map{*this};
+        map.insert(std::move(key), std::move(value));
+        return map;
+}
+
+Map Map::dissoc(const LisppObject& key) const
+{
+        Map map{*this};
+        map.erase(key);
+        return map;
+}
+
+void Map::insert(LisppObject key, LisppObject value)
+{
+        MapEntry entry;
+        entry.hash = compare::hash(key);
+        entry.key = std::move(key);
+        entry.value = std::move(value);
+        if (insert_node(root, 0, std::move(entry))) {
+                count++;
+        }
+}
+
+void Map::erase(const LisppObject& key)
+{
+        if (find(key) == nullptr) {
+                return;
+        }
+        erase_node(root, 0, compare::hash(key), key);
+        count--;
+}
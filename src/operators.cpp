@@ -1,100 +1,575 @@
 #include "operators.h"
 
+#include <charconv>
+#include <cstring>
+
+#include "footprint.h"
+#include "gc.h"
+#include "profiler.h"
+
 using namespace type;
 
 namespace {
 
-LisppObject equal_helper(const LisppObject& l1, const LisppObject& l2)
+// Numeric Helpers
+//
+// Exact integers stay exact: 64-bit operands use checked arithmetic and
+// promote to bignums on overflow, and bignum results that fit in 64 bits are
+// demoted again. Only a double operand makes an operation inexact.
+
+bool is_exact(const LisppObject& a, const LisppObject& b)
 {
-        if (l1.type != l2.type) {
-                return LisppObject::create_false();
+        return a.is_exact() && b.is_exact();
+}
+
+// Decimal Helpers
+//
+// Decimals run on the immediate's 64-bit unscaled part with checked
+// arithmetic and only spill to `decimal::Decimal` when a result overflows or
+// needs more digits than the immediate holds. An exact integer operand acts
+// as a decimal at scale 0; a double operand makes the result a double.
+
+bool is_decimal(const LisppObject& a, const LisppObject& b)
+{
+        return (a.is_decimal() || b.is_decimal()) && !a.is_float() &&
+               !b.is_float();
+}
+
+const int64_t powers_of_ten[] = {1,
+                                 10,
+                                 100,
+                                 1000,
+                                 10000,
+                                 100000,
+                                 1000000,
+                                 10000000,
+                                 100000000,
+                                 1000000000,
+                                 10000000000,
+                                 100000000000,
+                                 1000000000000,
+                                 10000000000000,
+                                 100000000000000,
+                                 1000000000000000,
+                                 10000000000000000,
+                                 100000000000000000,
+                                 1000000000000000000};
+
+// Reads an immediate decimal or integer as its unscaled part and scale.
+bool fixed(const LisppObject& value, int64_t& unscaled, uint32_t& scale)
+{
+        if (value.is_integer()) {
+                unscaled = value.integer();
+                scale = 0;
+                return true;
+        }
+        if (value.type() == Type::Decimal) {
+                unscaled = value.decimal_unscaled();
+                scale = value.decimal_scale();
+                return true;
+        }
+        return false;
+}
+
+// `unscaled` moved from `from` to `to` >= `from` digits, unless it overflows.
+bool widen(int64_t unscaled, uint32_t from, uint32_t to, int64_t& widened)
+{
+        return to - from <= 18 &&
+               !__builtin_mul_overflow(unscaled, powers_of_ten[to - from],
+                                       &widened);
+}
+
+LisppObject add_decimals(const LisppObject& a, const LisppObject& b)
+{
+        int64_t x, y, sum;
+        uint32_t scale_x, scale_y;
+        if (fixed(a, x, scale_x) && fixed(b, y, scale_y)) {
+                uint32_t scale = std::max(scale_x, scale_y);
+                if (widen(x, scale_x, scale, x) &&
+                    widen(y, scale_y, scale, y) &&
+                    !__builtin_add_overflow(x, y, &sum)) {
+                        return LisppObject::create_decimal(sum, scale);
+                }
+        }
+        return LisppObject::create_decimal(
+            decimal::add(a.decimal(), b.decimal()));
+}
+
+LisppObject sub_decimals(const LisppObject& a, const LisppObject& b)
+{
+        int64_t x, y, diff;
+        uint32_t scale_x, scale_y;
+        if (fixed(a, x, scale_x) && fixed(b, y, scale_y)) {
+                uint32_t scale = std::max(scale_x, scale_y);
+                if (widen(x, scale_x, scale, x) &&
+                    widen(y, scale_y, scale, y) &&
+                    !__builtin_sub_overflow(x, y, &diff)) {
+                        return LisppObject::create_decimal(diff, scale);
+                }
+        }
+        return LisppObject::create_decimal(
+            decimal::sub(a.decimal(), b.decimal()));
+}
+
+// Products are exact: the scale is the sum of the operands' scales.
+LisppObject mul_decimals(const LisppObject& a, const LisppObject& b)
+{
+        int64_t x, y, prod;
+        uint32_t scale_x, scale_y;
+        if (fixed(a, x, scale_x) && fixed(b, y, scale_y) &&
+            scale_x + scale_y <= UINT8_MAX &&
+            !__builtin_mul_overflow(x, y, &prod)) {
+                return LisppObject::create_decimal(prod, scale_x + scale_y);
         }
-        switch (l1.type) {
-        case Type::Number:
-                return (l1.number == l2.number) ? LisppObject::create_true()
-                                                : LisppObject::create_false();
-        case Type::String:
-                return (l1.string == l2.string) ? LisppObject::create_true()
-                                                : LisppObject::create_false();
-        case Type::List:
-                for (unsigned long i = 0; i < l1.items.size(); i++) {
-                        auto predicate = equal_helper(l1.items[i], l2.items[i]);
-                        if (predicate.is_false()) {
-                                return LisppObject::create_false();
+        return LisppObject::create_decimal(
+            decimal::mul(a.decimal(), b.decimal()));
+}
+
+// a / b rounded to `scale` digits after the point.
+LisppObject div_decimals(const LisppObject& a, const LisppObject& b,
+                         uint32_t scale, decimal::Rounding mode)
+{
+        int64_t x, y;
+        uint32_t scale_x, scale_y;
+        if (fixed(a, x, scale_x) && fixed(b, y, scale_y) && y != 0 &&
+            scale <= UINT8_MAX) {
+                // The quotient at `scale` is x * 10^shift / y, which fits
+                // 128 bits whenever the power of ten is in the table.
+                int64_t shift = int64_t{scale} + scale_y - scale_x;
+                if (shift >= 0 && shift <= 18) {
+                        __int128 n = static_cast<__int128>(x) *
+                                     powers_of_ten[shift];
+                        __int128 quotient = n / y;
+                        __int128 remainder = n % y;
+                        if (remainder != 0) {
+                                __int128 twice = remainder < 0 ? -2 * remainder
+                                                               : 2 * remainder;
+                                __int128 divisor = y < 0 ? -__int128{y} : y;
+                                int half = (twice > divisor) - (twice < divisor);
+                                bool negative = (n < 0) != (y < 0);
+                                if (decimal::round_away(mode, negative, half,
+                                                        quotient & 1)) {
+                                        quotient += negative ? -1 : 1;
+                                }
+                        }
+                        if (quotient >= INT64_MIN && quotient <= INT64_MAX) {
+                                return LisppObject::create_decimal(
+                                    static_cast<int64_t>(quotient), scale);
                         }
                 }
-                return LisppObject::create_true();
-        default:
-                return LisppObject::create_false();
+        }
+        return LisppObject::create_decimal(
+            decimal::div(a.decimal(), b.decimal(), scale, mode));
+}
+
+LisppObject add_numbers(const LisppObject& a, const LisppObject& b)
+{
+        int64_t sum;
+        if (a.is_integer() && b.is_integer() &&
+            !__builtin_add_overflow(a.integer(), b.integer(), &sum)) {
+                return LisppObject::create_integer(sum);
+        }
+        if (is_exact(a, b)) {
+                return LisppObject::create_bignum(a.bigint() + b.bigint());
+        }
+        if (is_decimal(a, b)) {
+                return add_decimals(a, b);
+        }
+        return LisppObject::create_number(a.number() + b.number());
+}
+
+LisppObject sub_numbers(const LisppObject& a, const LisppObject& b)
+{
+        int64_t diff;
+        if (a.is_integer() && b.is_integer() &&
+            !__builtin_sub_overflow(a.integer(), b.integer(), &diff)) {
+                return LisppObject::create_integer(diff);
+        }
+        if (is_exact(a, b)) {
+                return LisppObject::create_bignum(a.bigint() - b.bigint());
+        }
+        if (is_decimal(a, b)) {
+                return sub_decimals(a, b);
+        }
+        return LisppObject::create_number(a.number() - b.number());
+}
+
+LisppObject mul_numbers(const LisppObject& a, const LisppObject& b)
+{
+        int64_t prod;
+        if (a.is_integer() && b.is_integer() &&
+            !__builtin_mul_overflow(a.integer(), b.integer(), &prod)) {
+                return LisppObject::create_integer(prod);
+        }
+        if (is_exact(a, b)) {
+                return LisppObject::create_bignum(a.bigint() * b.bigint());
+        }
+        if (is_decimal(a, b)) {
+                return mul_decimals(a, b);
+        }
+        return LisppObject::create_number(a.number() * b.number());
+}
+
+// Exact division stays exact when the divisor divides evenly. Decimal
+// quotients keep the larger operand scale, rounding half to even.
+LisppObject div_numbers(const LisppObject& a, const LisppObject& b)
+{
+        if (is_decimal(a, b)) {
+                return div_decimals(
+                    a, b, std::max(a.decimal_scale(), b.decimal_scale()),
+                    decimal::Rounding::half_even);
+        }
+        if (b.number() == 0) {
+                throw std::runtime_error("\n;Infinity. Division by zero.\n");
+        }
+        if (a.is_integer() && b.is_integer()) {
+                if (!(a.integer() == INT64_MIN && b.integer() == -1) &&
+                    a.integer() % b.integer() == 0) {
+                        return LisppObject::create_integer(a.integer() /
+                                                           b.integer());
+                }
+        }
+        if (is_exact(a, b)) {
+                bignum::BigInt quotient, remainder;
+                bignum::BigInt::divmod(a.bigint(), b.bigint(), quotient,
+                                       remainder);
+                if (remainder.is_zero()) {
+                        return LisppObject::create_bignum(quotient);
+                }
+        }
+        return LisppObject::create_number(a.number() / b.number());
+}
+
+size_t to_index(const LisppObject& index)
+{
+        if (!index.is_integer() || index.integer() < 0) {
+                throw std::runtime_error(
+                    "\n;Index must be a non-negative integer.\n");
+        }
+        return static_cast<size_t>(index.integer());
+}
+
+uint32_t to_scale(const LisppObject& scale)
+{
+        size_t digits = to_index(scale);
+        if (digits > UINT32_MAX) {
+                throw std::runtime_error("\n;Decimal scale is too large.\n");
+        }
+        return static_cast<uint32_t>(digits);
+}
+
+// The rounding mode named by the optional argument at `index`: a string
+// such as "half-up". Defaults to rounding half to even.
+decimal::Rounding to_rounding(const Arguments& args, size_t index)
+{
+        if (index >= args.size()) {
+                return decimal::Rounding::half_even;
+        }
+        auto mode = decimal::rounding_from_string(args[index].string());
+        if (!args[index].is_string() || !mode.has_value()) {
+                throw std::runtime_error(
+                    "\n;Unknown rounding mode. Expected one of \"half-even\", "
+                    "\"half-up\", \"half-down\", \"down\", \"up\", "
+                    "\"floor\" or \"ceiling\".\n");
+        }
+        return *mode;
+}
+
+// A number as an exact decimal. Doubles convert through their shortest
+// round-tripping text, so 0.1 becomes 0.1M.
+decimal::Decimal to_decimal(const LisppObject& number)
+{
+        if (!number.is_float()) {
+                return number.decimal();
+        }
+        char text[512];
+        auto [end, ec] = std::to_chars(text, text + sizeof(text),
+                                       number.number(),
+                                       std::chars_format::fixed);
+        auto value = ec == std::errc()
+                         ? decimal::from_string({text, size_t(end - text)})
+                         : std::nullopt;
+        if (!value.has_value()) {
+                throw std::runtime_error(
+                    "\n;Cannot convert " + printer::print(number) +
+                    " to a decimal.\n");
+        }
+        return *value;
+}
+
+// Decodes an unsigned `width`-byte integer from (<bytes> <offset>). Values
+// past the int64 range become bignums.
+LisppObject read_unsigned(const Arguments& args,
+                          const std::string& name, size_t width,
+                          bool big_endian)
+{
+        if (args.size() != 2) {
+                throw exception::invalid_arg_size(
+                        "(" + name + " <bytes> <offset>)", 2, args.size());
+        }
+        uint64_t value = args.front().bytes().read_unsigned(
+            to_index(args.at(1)), width, big_endian);
+        if (value <= static_cast<uint64_t>(INT64_MAX)) {
+                return LisppObject::create_integer(static_cast<int64_t>(value));
+        }
+        bignum::BigInt half{static_cast<int64_t>(value >> 1)};
+        bignum::BigInt low{static_cast<int64_t>(value & 1)};
+        return LisppObject::create_bignum(half + half + low);
+}
+
+LisppObject read_double(const Arguments& args,
+                        const std::string& name, bool big_endian)
+{
+        if (args.size() != 2) {
+                throw exception::invalid_arg_size(
+                        "(" + name + " <bytes> <offset>)", 2, args.size());
+        }
+        uint64_t bits = args.front().bytes().read_unsigned(
+            to_index(args.at(1)), sizeof(double), big_endian);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return LisppObject::create_number(value);
+}
+
+// Map Helpers
+//
+// The map builtins accept hash and sorted maps alike.
+
+size_t entry_count(const LisppObject& map)
+{
+        return map.is_sorted_map() ? map.sorted_map().size()
+                                   : map.map().size();
+}
+
+const LisppObject* lookup(const LisppObject& map, const LisppObject& key)
+{
+        return map.is_sorted_map() ? map.sorted_map().find(key)
+                                   : map.map().find(key);
+}
+
+template <typename Visit>
+void for_each_entry(const LisppObject& map, Visit visit)
+{
+        if (map.is_sorted_map()) {
+                map.sorted_map().for_each(visit);
+        }
+        else {
+                map.map().for_each(visit);
         }
 }
 
+template <typename Entries>
+Entries assoc_entries(Entries map, const Arguments& args)
+{
+        for (size_t i = 1; i < args.size(); i += 2) {
+                map.insert(args[i], args[i + 1]);
+        }
+        return map;
+}
+
+template <typename Entries>
+Entries dissoc_entries(Entries map, const Arguments& args)
+{
+        for (auto it = args.begin() + 1; it != args.end(); it++) {
+                map.erase(*it);
+        }
+        return map;
+}
+
 } // namespace
 
 // Arithmetic
 
-/// (+ <atom-1> ... <atom-n>) -> LisppObject.Number
-LisppObject operators::add(std::vector<LisppObject> args)
+/// (+ <atom-1> ... <atom-n>) -> LisppObject.Integer | LisppObject.Number
+LisppObject operators::add(Arguments args)
 {
-        auto sum = 0.0;
+        auto sum = LisppObject::create_integer(0);
         for (const auto& arg : args) {
-                sum += arg.number;
+                sum = add_numbers(sum, arg);
         }
-        return LisppObject::create_number(sum);
+        return sum;
 }
 
-/// (- <atom-1> ... <atom-n>) -> LisppObject.Number
-LisppObject operators::sub(std::vector<LisppObject> args)
+/// (- <atom-1> ... <atom-n>) -> LisppObject.Integer | LisppObject.Number
+LisppObject operators::sub(Arguments args)
 {
         if (args.empty()) {
                 throw std::invalid_argument("\n;NaN. 0 arguments given.\n");
         }
         if (args.size() == 1) {
-                auto num = args.at(0).number;
-                return LisppObject::create_number(num * -1);
+                return sub_numbers(LisppObject::create_integer(0), args.at(0));
         }
-        auto diff = args.at(0).number;
+        auto diff = args.at(0);
         for (auto it = args.begin() + 1; it != args.end(); it++) {
-                diff -= it->number;
+                diff = sub_numbers(diff, *it);
         }
-        return LisppObject::create_number(diff);
+        return diff;
 }
 
-/// (* <atom-1> ... <atom-n>) -> LisppObject.Number
-LisppObject operators::mul(std::vector<LisppObject> args)
+/// (* <atom-1> ... <atom-n>) -> LisppObject.Integer | LisppObject.Number
+LisppObject operators::mul(Arguments args)
 {
-        auto prod = 1.0;
+        auto prod = LisppObject::create_integer(1);
         for (const auto& arg : args) {
-                prod *= arg.number;
+                prod = mul_numbers(prod, arg);
         }
-        return LisppObject::create_number(prod);
+        return prod;
 }
 
-/// (/ <atom-1> ... <atom-n>) -> LisppObject.Number
-LisppObject operators::div(std::vector<LisppObject> args)
+/// (/ <atom-1> ... <atom-n>) -> LisppObject.Integer | LisppObject.Number
+LisppObject operators::div(Arguments args)
 {
         if (args.empty()) {
                 throw std::runtime_error("\n;NaN. 0 arguments given.\n");
         }
         if (args.size() == 1) {
-                auto num = args.at(0).number;
-                return LisppObject::create_number(1.0 / num);
+                return div_numbers(LisppObject::create_integer(1), args.at(0));
         }
-        auto quotient = args.at(0).number;
+        auto quotient = args.at(0);
         for (auto it = args.begin() + 1; it != args.end(); it++) {
-                if (it->number == 0) {
-                        throw std::runtime_error(
-                            "\n;Infinity. Division by zero.\n");
+                quotient = div_numbers(quotient, *it);
+        }
+        return quotient;
+}
+
+// Decimals
+
+/// (decimal <number> <scale>? <mode>?) -> LisppObject.Decimal
+LisppObject operators::decimal(Arguments args)
+{
+        if (args.empty() || args.size() > 3) {
+                throw exception::invalid_arg_size(
+                        "(decimal <number> <scale>? <mode>?)", 1, args.size());
+        }
+        if (!args.front().is_number()) {
+                throw std::runtime_error("\n;(decimal <number>) expects a "
+                                         "number.\n");
+        }
+        auto value = to_decimal(args.front());
+        if (args.size() > 1) {
+                value = decimal::rescale(value, to_scale(args.at(1)),
+                                         to_rounding(args, 2));
+        }
+        return LisppObject::create_decimal(std::move(value));
+}
+
+/// (decimal-div <number> <number> <scale> <mode>?) -> LisppObject.Decimal
+LisppObject operators::decimal_div(Arguments args)
+{
+        if (args.size() != 3 && args.size() != 4) {
+                throw exception::invalid_arg_size(
+                        "(decimal-div <number> <number> <scale> <mode>?)", 3,
+                        args.size());
+        }
+        if (!args.at(0).is_number() || !args.at(1).is_number()) {
+                throw std::runtime_error("\n;(decimal-div <number> <number> "
+                                         "<scale>) expects numbers.\n");
+        }
+        auto dividend = args.at(0).is_float()
+                            ? LisppObject::create_decimal(to_decimal(args[0]))
+                            : args[0];
+        auto divisor = args.at(1).is_float()
+                           ? LisppObject::create_decimal(to_decimal(args[1]))
+                           : args[1];
+        return div_decimals(dividend, divisor, to_scale(args.at(2)),
+                            to_rounding(args, 3));
+}
+
+// Introspection
+
+/// (sizeof-deep <any>) -> LisppObject.Integer
+LisppObject operators::sizeof_deep(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(sizeof-deep <any>)", 1, args.size());
+        }
+        return LisppObject::create_integer(
+            static_cast<int64_t>(footprint::deep_size(args.front())));
+}
+
+/// (gc) -> LisppObject.Integer: the number of cells reclaimed
+LisppObject operators::collect(Arguments args)
+{
+        if (!args.empty()) {
+                throw exception::invalid_arg_size("(gc)", 0, args.size());
+        }
+        return LisppObject::create_integer(
+            static_cast<int64_t>(gc::collect()));
+}
+
+/// (gc-stats) -> LisppObject.Map
+LisppObject operators::gc_stats(Arguments args)
+{
+        if (!args.empty()) {
+                throw exception::invalid_arg_size("(gc-stats)", 0, args.size());
+        }
+        const gc::Stats& stats = gc::stats();
+        Map map;
+        auto entry = [&](const char* key, uint64_t value) {
+                map.insert(LisppObject::create_string(key),
+                           LisppObject::create_integer(
+                               static_cast<int64_t>(value)));
+        };
+        entry("collections", stats.collections);
+        entry("slices", stats.slices);
+        entry("reclaimed-cells", stats.reclaimed_cells);
+        entry("candidates", stats.candidates);
+        entry("last-pause-us", stats.last_pause_us);
+        entry("max-pause-us", stats.max_pause_us);
+        entry("total-pause-us", stats.total_pause_us);
+        entry("heap-bytes", heap_usage.bytes);
+        entry("peak-heap-bytes", heap_usage.peak_bytes);
+        entry("heap-cells", heap_usage.cells);
+        // Pauses by bucket, keyed by the bucket's upper bound in
+        // microseconds; the last bucket has none.
+        SortedMap pauses;
+        for (size_t i = 0; i < stats.pauses.size(); i++) {
+                if (stats.pauses[i] == 0) {
+                        continue;
                 }
-                quotient /= it->number;
+                auto bound = i + 1 < stats.pauses.size()
+                                 ? LisppObject::create_integer(int64_t{1} << i)
+                                 : LisppObject::create_string("inf");
+                pauses.insert(bound, LisppObject::create_integer(
+                                         static_cast<int64_t>(stats.pauses[i])));
+        }
+        map.insert(LisppObject::create_string("pause-histogram"),
+                   LisppObject::create_sorted_map(std::move(pauses)));
+        return LisppObject::create_map(std::move(map));
+}
+
+/// (alloc-profile) -> LisppObject.String: the sampled bytes by call stack
+/// (alloc-profile "count") -> LisppObject.String: the sampled allocations
+/// (alloc-profile <sample-bytes>) -> LisppObject.Nil: restarts sampling;
+/// zero stops it
+LisppObject operators::alloc_profile(Arguments args)
+{
+        if (args.size() > 1) {
+                throw exception::invalid_arg_size(
+                    "(alloc-profile <sample-bytes>?)", 1, args.size());
+        }
+        if (args.empty()) {
+                return LisppObject::create_string(profiler::report());
+        }
+        const auto& arg = args.front();
+        if (arg.is_string() && arg.string() == "count") {
+                return LisppObject::create_string(
+                    profiler::report(profiler::Weight::count));
         }
-        return LisppObject::create_number(quotient);
+        if (!arg.is_integer() || arg.integer() < 0) {
+                throw std::runtime_error(
+                    "\n;(alloc-profile <sample-bytes>) expects a "
+                    "non-negative integer or \"count\".\n");
+        }
+        profiler::start(static_cast<size_t>(arg.integer()));
+        return LisppObject::create_nil();
 }
 
 // I/O
 
 /// (print <any>) -> LisppObject.Nil
-LisppObject operators::print(std::vector<LisppObject> args)
+LisppObject operators::print(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
@@ -107,88 +582,656 @@ LisppObject operators::print(std::vector<LisppObject> args)
 // List Processing
 
 // (list <atom-1 | list-1> ... <atom-n | list-n> ) -> LisppObject.List
-LisppObject operators::list(std::vector<LisppObject> args)
+LisppObject operators::list(Arguments args)
 {
-        return LisppObject::create_list(args);
+        return LisppObject::create_list(List{args.data(), args.size()});
 }
 
-/// (empty? <list>) -> LisppObject.True | LisppObject.False
-LisppObject operators::is_empty(std::vector<LisppObject> args)
+/// (empty? <list | map>) -> LisppObject.True | LisppObject.False
+LisppObject operators::is_empty(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(empty? <list>)", 1, args.size());
         }
-        auto list = args.front();
-        return list.items.empty() ? LisppObject::create_true()
-                                  : LisppObject::create_false();
+        const auto& list = args.front();
+        if (list.is_pair()) {
+                return LisppObject::create_false();
+        }
+        if (list.is_map() || list.is_sorted_map()) {
+                return LisppObject::create_boolean(entry_count(list) == 0);
+        }
+        if (list.is_f64vec()) {
+                return LisppObject::create_boolean(list.f64vec().empty());
+        }
+        if (list.is_bytes()) {
+                return LisppObject::create_boolean(list.bytes().empty());
+        }
+        if (list.is_string()) {
+                return LisppObject::create_boolean(list.string_size() == 0);
+        }
+        return LisppObject::create_boolean(list.items().empty());
 }
 
-/// (count <list>) -> LisppObject.Number
-LisppObject operators::count(std::vector<LisppObject> args)
+/// (count <list | map>) -> LisppObject.Integer
+LisppObject operators::count(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(count <list>)", 1, args.size());
         }
-        auto list = args.front();
-        auto count = list.items.size();
-        return LisppObject::create_number(count); // (size_t -> double) cast
+        const auto& list = args.front();
+        if (list.is_map() || list.is_sorted_map()) {
+                return LisppObject::create_integer(
+                    static_cast<int64_t>(entry_count(list)));
+        }
+        if (list.is_f64vec()) {
+                return LisppObject::create_integer(
+                    static_cast<int64_t>(list.f64vec().size()));
+        }
+        if (list.is_bytes()) {
+                return LisppObject::create_integer(
+                    static_cast<int64_t>(list.bytes().size()));
+        }
+        if (list.is_string()) {
+                return LisppObject::create_integer(
+                    static_cast<int64_t>(list.string_size()));
+        }
+        if (list.is_transient()) {
+                return LisppObject::create_integer(
+                    static_cast<int64_t>(args.front().transient()->size()));
+        }
+        if (list.is_pair()) {
+                int64_t count = 0;
+                const LisppObject* cell = &list;
+                for (; cell->is_pair(); cell = &cell->cdr()) {
+                        count++;
+                }
+                return LisppObject::create_integer(
+                    count + static_cast<int64_t>(cell->items().size()));
+        }
+        auto count = static_cast<int64_t>(list.items().size());
+        return LisppObject::create_integer(count);
 }
 
 /// (first <list>) -> LisppObject
-LisppObject operators::first(std::vector<LisppObject> args)
+LisppObject operators::first(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(first <list>)", 1, args.size());
         }
 
-        auto list = args.front();
-        if (list.items.empty()) {
+        const auto& list = args.front();
+        if (list.is_pair()) {
+                return list.car();
+        }
+        if (list.items().empty()) {
                 throw std::runtime_error(
                     "\n;Empty List. Cannot return the (first <list>) "
                     "element.\n");
         }
-        return list.items.front();
+        return list.items().front();
 }
 
 /// (rest <list>) -> (list LisppObject)
-LisppObject operators::rest(std::vector<LisppObject> args)
+LisppObject operators::rest(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(rest <list>)", 1, args.size());
         }
 
-        auto list = args.front();
-        if (list.items.empty()) {
+        const auto& list = args.front();
+        if (list.is_pair()) {
+                return list.cdr();
+        }
+        if (list.items().empty()) {
                 throw std::runtime_error(
                     "\n;Empty List. Cannot return the (rest <list>) "
                     "of the elements.\n");
         }
-        if (list.items.size() == 1) {
-                return LisppObject::create_list({});
+        return LisppObject::create_list(list.items().rest());
+}
+
+/// (cons <any> <list>) -> LisppObject.Pair
+LisppObject operators::cons(Arguments args)
+{
+        if (args.size() != 2) {
+                throw exception::invalid_arg_size(
+                        "(cons <any> <list>)", 2, args.size());
+        }
+        return LisppObject::create_pair(args.at(0), args.at(1));
+}
+
+/// (nth <list> <index>) -> LisppObject
+LisppObject operators::nth(Arguments args)
+{
+        if (args.size() != 2) {
+                throw exception::invalid_arg_size(
+                        "(nth <list> <index>)", 2, args.size());
+        }
+        return args.front().items().at(to_index(args.at(1)));
+}
+
+/// (conj <list> <any>) -> LisppObject.List
+LisppObject operators::conj(Arguments args)
+{
+        if (args.size() != 2) {
+                throw exception::invalid_arg_size(
+                        "(conj <list> <any>)", 2, args.size());
+        }
+        return LisppObject::create_list(args.front().items().conj(args.at(1)));
+}
+
+// Strings
+
+/// (string-length <string>) -> LisppObject.Integer
+LisppObject operators::string_length(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(string-length <string>)", 1, args.size());
+        }
+        if (!args.front().is_string()) {
+                throw std::runtime_error(
+                    "\n;(string-length <string>) expects a string.\n");
+        }
+        return LisppObject::create_integer(
+            static_cast<int64_t>(args.front().string_size()));
+}
+
+/// (substring <string> <start> <end>?) -> LisppObject.String
+LisppObject operators::substring(Arguments args)
+{
+        if (args.size() != 2 && args.size() != 3) {
+                throw exception::invalid_arg_size(
+                        "(substring <string> <start> <end>?)", 2, args.size());
+        }
+        const auto& string = args.front();
+        if (!string.is_string()) {
+                throw std::runtime_error(
+                    "\n;(substring <string> <start> <end>?) expects a "
+                    "string.\n");
+        }
+        size_t start = to_index(args.at(1));
+        size_t end = args.size() == 3 ? to_index(args.at(2))
+                                      : string.string_size();
+        if (start > end || end > string.string_size()) {
+                throw std::runtime_error(
+                    "\n;Substring bounds are out of range.\n");
+        }
+        return LisppObject::create_substring(string, start, end);
+}
+
+/// (string-append <string-1> ... <string-n>) -> LisppObject.String
+LisppObject operators::string_append(Arguments args)
+{
+        auto result = LisppObject::create_string("");
+        for (const auto& arg : args) {
+                if (!arg.is_string()) {
+                        throw std::runtime_error(
+                            "\n;(string-append <string> ...) expects "
+                            "strings.\n");
+                }
+                result = LisppObject::create_concat(result, arg);
+        }
+        return result;
+}
+
+/// (str <any-1> ... <any-n>) -> LisppObject.String
+LisppObject operators::str(Arguments args)
+{
+        auto result = LisppObject::create_string("");
+        for (const auto& arg : args) {
+                result = LisppObject::create_concat(
+                    result, arg.is_string()
+                                ? arg
+                                : LisppObject::create_string(
+                                      printer::print(arg)));
+        }
+        return result;
+}
+
+// Maps
+
+/// (hash-map <key-1> <value-1> ... <key-n> <value-n>) -> LisppObject.Map
+LisppObject operators::hash_map(Arguments args)
+{
+        if (args.size() % 2 != 0) {
+                throw std::runtime_error(
+                    "\n;(hash-map <key> <value> ...) requires an even number "
+                    "of arguments.\n");
+        }
+        Map map;
+        for (size_t i = 0; i < args.size(); i += 2) {
+                map.insert(args[i], args[i + 1]);
         }
-        std::vector<LisppObject> rest{list.items.begin() + 1, list.items.end()};
-        return LisppObject::create_list(rest);
+        return LisppObject::create_map(std::move(map));
+}
+
+/// (get <map | sorted-map> <key> <default>?) -> LisppObject
+LisppObject operators::get(Arguments args)
+{
+        if (args.size() != 2 && args.size() != 3) {
+                throw exception::invalid_arg_size(
+                        "(get <map> <key> <default>?)", 2, args.size());
+        }
+        const LisppObject* value = lookup(args.front(), args.at(1));
+        if (value != nullptr) {
+                return *value;
+        }
+        return args.size() == 3 ? args.at(2) : LisppObject::create_nil();
+}
+
+/// (assoc <map> <key> <value> ...) -> LisppObject.Map | LisppObject.SortedMap
+LisppObject operators::assoc(Arguments args)
+{
+        if (args.size() < 3 || args.size() % 2 != 1) {
+                throw std::runtime_error(
+                    "\n;(assoc <map> <key> <value> ...) requires a map and "
+                    "key-value pairs.\n");
+        }
+        if (args.front().is_sorted_map()) {
+                return LisppObject::create_sorted_map(
+                    assoc_entries(args.front().sorted_map(), args));
+        }
+        return LisppObject::create_map(assoc_entries(args.front().map(), args));
+}
+
+/// (dissoc <map> <key> ...) -> LisppObject.Map | LisppObject.SortedMap
+LisppObject operators::dissoc(Arguments args)
+{
+        if (args.empty()) {
+                throw exception::invalid_arg_size(
+                        "(dissoc <map> <key> ...)", 1, args.size());
+        }
+        if (args.front().is_sorted_map()) {
+                return LisppObject::create_sorted_map(
+                    dissoc_entries(args.front().sorted_map(), args));
+        }
+        return LisppObject::create_map(
+            dissoc_entries(args.front().map(), args));
+}
+
+/// (keys <map>) -> LisppObject.List
+LisppObject operators::keys(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(keys <map>)", 1, args.size());
+        }
+        List keys;
+        for_each_entry(args.front(),
+            [&](const LisppObject& key, const LisppObject&) {
+                    keys.push_back(key);
+            });
+        return LisppObject::create_list(std::move(keys));
+}
+
+/// (vals <map>) -> LisppObject.List
+LisppObject operators::vals(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(vals <map>)", 1, args.size());
+        }
+        List vals;
+        for_each_entry(args.front(),
+            [&](const LisppObject&, const LisppObject& value) {
+                    vals.push_back(value);
+            });
+        return LisppObject::create_list(std::move(vals));
+}
+
+/// (contains? <map> <key>) -> LisppObject.True | LisppObject.False
+LisppObject operators::contains(Arguments args)
+{
+        if (args.size() != 2) {
+                throw exception::invalid_arg_size(
+                        "(contains? <map> <key>)", 2, args.size());
+        }
+        return LisppObject::create_boolean(lookup(args.front(), args.at(1)) !=
+                                           nullptr);
+}
+
+/// (sorted-map <key> <value> ...) -> LisppObject.SortedMap
+LisppObject operators::sorted_map(Arguments args)
+{
+        if (args.size() % 2 != 0) {
+                throw std::runtime_error(
+                    "\n;(sorted-map <key> <value> ...) requires an even "
+                    "number of arguments.\n");
+        }
+        SortedMap map;
+        for (size_t i = 0; i < args.size(); i += 2) {
+                map.insert(args[i], args[i + 1]);
+        }
+        return LisppObject::create_sorted_map(std::move(map));
+}
+
+/// (subrange <sorted-map> <low> <high>) -> LisppObject.SortedMap
+LisppObject operators::subrange(Arguments args)
+{
+        if (args.size() != 3) {
+                throw exception::invalid_arg_size(
+                        "(subrange <sorted-map> <low> <high>)", 3, args.size());
+        }
+        return LisppObject::create_sorted_map(
+            args.front().sorted_map().subrange(args.at(1), args.at(2)));
+}
+
+/// (first-key <sorted-map>) -> LisppObject
+LisppObject operators::first_key(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(first-key <sorted-map>)", 1, args.size());
+        }
+        const LisppObject* key = args.front().sorted_map().first_key();
+        return key != nullptr ? *key : LisppObject::create_nil();
+}
+
+/// (last-key <sorted-map>) -> LisppObject
+LisppObject operators::last_key(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(last-key <sorted-map>)", 1, args.size());
+        }
+        const LisppObject* key = args.front().sorted_map().last_key();
+        return key != nullptr ? *key : LisppObject::create_nil();
+}
+
+// Transients
+
+/// (transient <list | map | sorted-map>) -> LisppObject.Transient
+LisppObject operators::transient(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(transient <list | map>)", 1, args.size());
+        }
+        return LisppObject::create_transient(Transient{args.front()});
+}
+
+/// (conj! <transient> <any-1> ... <any-n>) -> LisppObject.Transient
+LisppObject operators::conj_in_place(Arguments args)
+{
+        if (args.empty() || !args.front().is_transient()) {
+                throw std::runtime_error(
+                    "\n;(conj! <transient> <any> ...) expects a transient.\n");
+        }
+        Transient* builder = args.front().transient();
+        for (auto it = args.begin() + 1; it != args.end(); it++) {
+                builder->conj(std::move(*it));
+        }
+        return std::move(args.front());
+}
+
+/// (assoc! <transient> <key-1> <value-1> ...) -> LisppObject.Transient
+LisppObject operators::assoc_in_place(Arguments args)
+{
+        if (args.empty() || !args.front().is_transient() ||
+            args.size() % 2 != 1) {
+                throw std::runtime_error(
+                    "\n;(assoc! <transient> <key> <value> ...) expects a "
+                    "transient and key-value pairs.\n");
+        }
+        Transient* builder = args.front().transient();
+        for (size_t i = 1; i < args.size(); i += 2) {
+                builder->assoc(std::move(args[i]), std::move(args[i + 1]));
+        }
+        return std::move(args.front());
+}
+
+/// (dissoc! <transient> <key-1> ... <key-n>) -> LisppObject.Transient
+LisppObject operators::dissoc_in_place(Arguments args)
+{
+        if (args.empty() || !args.front().is_transient()) {
+                throw std::runtime_error(
+                    "\n;(dissoc! <transient> <key> ...) expects a "
+                    "transient.\n");
+        }
+        Transient* builder = args.front().transient();
+        for (auto it = args.begin() + 1; it != args.end(); it++) {
+                builder->dissoc(*it);
+        }
+        return std::move(args.front());
+}
+
+/// (persistent! <transient>) -> LisppObject.List | LisppObject.Map
+LisppObject operators::persistent(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(persistent! <transient>)", 1, args.size());
+        }
+        if (!args.front().is_transient()) {
+                throw std::runtime_error(
+                    "\n;(persistent! <transient>) expects a transient.\n");
+        }
+        return args.front().transient()->persistent();
+}
+
+// Unboxed Vectors
+
+/// (f64vec <list>) | (f64vec <number-1> ... <number-n>) -> LisppObject.F64Vec
+LisppObject operators::f64vec(Arguments args)
+{
+        std::vector<LisppObject> numbers;
+        if (args.size() == 1 && args.front().is_list()) {
+                const auto& items = args.front().items();
+                numbers.assign(items.begin(), items.end());
+        }
+        else if (args.size() == 1 && args.front().is_pair()) {
+                const LisppObject* cell = &args.front();
+                for (; cell->is_pair(); cell = &cell->cdr()) {
+                        numbers.push_back(cell->car());
+                }
+        }
+        else {
+                numbers.assign(args.begin(), args.end());
+        }
+        F64Vec vec{numbers.size()};
+        double* values = vec.mutable_data();
+        for (size_t i = 0; i < numbers.size(); i++) {
+                if (!numbers[i].is_number()) {
+                        throw std::runtime_error(
+                            "\n;f64vec elements must be numbers.\n");
+                }
+                values[i] = numbers[i].number();
+        }
+        return LisppObject::create_f64vec(std::move(vec));
+}
+
+/// (f64vec-get <f64vec> <index>) -> LisppObject.Number
+LisppObject operators::f64vec_get(Arguments args)
+{
+        if (args.size() != 2) {
+                throw exception::invalid_arg_size(
+                        "(f64vec-get <f64vec> <index>)", 2, args.size());
+        }
+        return LisppObject::create_number(
+            args.front().f64vec().at(to_index(args.at(1))));
+}
+
+/// (f64vec-set <f64vec> <index> <number>) -> LisppObject.F64Vec
+LisppObject operators::f64vec_set(Arguments args)
+{
+        if (args.size() != 3) {
+                throw exception::invalid_arg_size(
+                        "(f64vec-set <f64vec> <index> <number>)", 3,
+                        args.size());
+        }
+        if (!args.at(2).is_number()) {
+                throw std::runtime_error(
+                    "\n;f64vec elements must be numbers.\n");
+        }
+        size_t index = to_index(args.at(1));
+        double value = args.at(2).number();
+        // A vector nothing else refers to is updated in place.
+        LisppObject vec = std::move(args.front());
+        if (F64Vec* owned = vec.unique_f64vec()) {
+                owned->set(index, value);
+                return vec;
+        }
+        F64Vec copy = vec.f64vec();
+        copy.set(index, value);
+        return LisppObject::create_f64vec(std::move(copy));
+}
+
+/// (f64vec-slice <f64vec> <start> <end>) -> LisppObject.F64Vec
+LisppObject operators::f64vec_slice(Arguments args)
+{
+        if (args.size() != 3) {
+                throw exception::invalid_arg_size(
+                        "(f64vec-slice <f64vec> <start> <end>)", 3,
+                        args.size());
+        }
+        return LisppObject::create_f64vec(args.front().f64vec().slice(
+            to_index(args.at(1)), to_index(args.at(2))));
+}
+
+/// (f64vec->list <f64vec>) -> LisppObject.List
+LisppObject operators::f64vec_to_list(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(f64vec->list <f64vec>)", 1, args.size());
+        }
+        const auto& vec = args.front().f64vec();
+        List list;
+        for (size_t i = 0; i < vec.size(); i++) {
+                list.push_back(LisppObject::create_number(vec[i]));
+        }
+        return LisppObject::create_list(std::move(list));
+}
+
+// Byte Vectors
+
+/// (bytes <list | string>) | (bytes <byte-1> ... <byte-n>) -> LisppObject.Bytes
+LisppObject operators::bytes(Arguments args)
+{
+        if (args.size() == 1 && args.front().is_string()) {
+                return LisppObject::create_bytes(Bytes{args.front().string()});
+        }
+        std::vector<LisppObject> values;
+        if (args.size() == 1 && args.front().is_list()) {
+                const auto& items = args.front().items();
+                values.assign(items.begin(), items.end());
+        }
+        else {
+                values.assign(args.begin(), args.end());
+        }
+        std::string buffer(values.size(), '\0');
+        for (size_t i = 0; i < values.size(); i++) {
+                if (!values[i].is_integer() || values[i].integer() < 0 ||
+                    values[i].integer() > 255) {
+                        throw std::runtime_error(
+                            "\n;bytes elements must be integers in [0, "
+                            "255].\n");
+                }
+                buffer[i] = static_cast<char>(values[i].integer());
+        }
+        return LisppObject::create_bytes(Bytes{buffer});
+}
+
+/// (load-bytes <path>) -> LisppObject.Bytes
+LisppObject operators::load_bytes(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(load-bytes <path>)", 1, args.size());
+        }
+        return LisppObject::create_bytes(
+            Bytes::map_file(std::string{args.front().string()}));
+}
+
+/// (bytes-ref <bytes> <index>) -> LisppObject.Integer
+LisppObject operators::bytes_ref(Arguments args)
+{
+        if (args.size() != 2) {
+                throw exception::invalid_arg_size(
+                        "(bytes-ref <bytes> <index>)", 2, args.size());
+        }
+        return LisppObject::create_integer(
+            args.front().bytes().at(to_index(args.at(1))));
+}
+
+/// (bytes-slice <bytes> <start> <end>) -> LisppObject.Bytes
+LisppObject operators::bytes_slice(Arguments args)
+{
+        if (args.size() != 3) {
+                throw exception::invalid_arg_size(
+                        "(bytes-slice <bytes> <start> <end>)", 3, args.size());
+        }
+        return LisppObject::create_bytes(args.front().bytes().slice(
+            to_index(args.at(1)), to_index(args.at(2))));
+}
+
+/// (read-u16-le <bytes> <offset>) -> LisppObject.Integer
+LisppObject operators::read_u16_le(Arguments args)
+{
+        return read_unsigned(args, "read-u16-le", 2, false);
+}
+
+/// (read-u16-be <bytes> <offset>) -> LisppObject.Integer
+LisppObject operators::read_u16_be(Arguments args)
+{
+        return read_unsigned(args, "read-u16-be", 2, true);
+}
+
+/// (read-u32-le <bytes> <offset>) -> LisppObject.Integer
+LisppObject operators::read_u32_le(Arguments args)
+{
+        return read_unsigned(args, "read-u32-le", 4, false);
+}
+
+/// (read-u32-be <bytes> <offset>) -> LisppObject.Integer
+LisppObject operators::read_u32_be(Arguments args)
+{
+        return read_unsigned(args, "read-u32-be", 4, true);
+}
+
+/// (read-u64-le <bytes> <offset>) -> LisppObject.Integer | LisppObject.Bignum
+LisppObject operators::read_u64_le(Arguments args)
+{
+        return read_unsigned(args, "read-u64-le", 8, false);
+}
+
+/// (read-u64-be <bytes> <offset>) -> LisppObject.Integer | LisppObject.Bignum
+LisppObject operators::read_u64_be(Arguments args)
+{
+        return read_unsigned(args, "read-u64-be", 8, true);
+}
+
+/// (read-f64-le <bytes> <offset>) -> LisppObject.Number
+LisppObject operators::read_f64_le(Arguments args)
+{
+        return read_double(args, "read-f64-le", false);
+}
+
+/// (read-f64-be <bytes> <offset>) -> LisppObject.Number
+LisppObject operators::read_f64_be(Arguments args)
+{
+        return read_double(args, "read-f64-be", true);
 }
 
 // Logical
 
 /// (not <any>) -> LisppObject.True | LisppObject.False
-LisppObject operators::_not(std::vector<LisppObject> args)
+LisppObject operators::_not(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(not <list>)", args.size(), 1);
         }
-        return (args.front().type == Type::False) ? LisppObject::create_true()
-                                                  : LisppObject::create_false();
+        return LisppObject::create_boolean(args.front().is_false());
 }
 
 /// (and <bool-1> ... <bool-n>) -> LisppObject.True | LisppObject.False
-LisppObject operators::_and(std::vector<LisppObject> args)
+LisppObject operators::_and(Arguments args)
 {
         for (const auto& arg : args) {
                 if (arg.is_false()) {
@@ -199,7 +1242,7 @@ LisppObject operators::_and(std::vector<LisppObject> args)
 }
 
 /// (and <bool-1> ... <bool-n>) -> LisppObject.True | LisppObject.False
-LisppObject operators::_or(std::vector<LisppObject> args)
+LisppObject operators::_or(Arguments args)
 {
         for (const auto& arg : args) {
                 if (arg.is_true()) {
@@ -212,10 +1255,10 @@ LisppObject operators::_or(std::vector<LisppObject> args)
 // Relational
 
 /// (< <atom-1> ... <atom-n>) -> LisppObject.True | LisppObject.False
-LisppObject operators::less(std::vector<LisppObject> args)
+LisppObject operators::less(Arguments args)
 {
         for (auto it = args.begin(); it != args.end() - 1; it++) {
-                if (it->number >= (it + 1)->number) {
+                if (compare::numbers(*it, *(it + 1)) >= 0) {
                         return LisppObject::create_false();
                 }
         }
@@ -223,10 +1266,10 @@ LisppObject operators::less(std::vector<LisppObject> args)
 }
 
 /// (<= <atom-1> ... <atom-n>) -> LisppObject.True | LisppObject.False
-LisppObject operators::less_eq(std::vector<LisppObject> args)
+LisppObject operators::less_eq(Arguments args)
 {
         for (auto it = args.begin(); it != args.end() - 1; it++) {
-                if (it->number > (it + 1)->number) {
+                if (compare::numbers(*it, *(it + 1)) > 0) {
                         return LisppObject::create_false();
                 }
         }
@@ -234,10 +1277,10 @@ LisppObject operators::less_eq(std::vector<LisppObject> args)
 }
 
 /// (> <atom-1> ... <atom-n>) -> LisppObject.True | LisppObject.False
-LisppObject operators::greater(std::vector<LisppObject> args)
+LisppObject operators::greater(Arguments args)
 {
         for (auto it = args.begin(); it != args.end() - 1; it++) {
-                if (it->number <= (it + 1)->number) {
+                if (compare::numbers(*it, *(it + 1)) <= 0) {
                         return LisppObject::create_false();
                 }
         }
@@ -245,10 +1288,10 @@ LisppObject operators::greater(std::vector<LisppObject> args)
 }
 
 /// (>= <atom-1> ... <atom-n>) -> LisppObject.True | LisppObject.False
-LisppObject operators::greater_eq(std::vector<LisppObject> args)
+LisppObject operators::greater_eq(Arguments args)
 {
         for (auto it = args.begin(); it != args.end() - 1; it++) {
-                if (it->number < (it + 1)->number) {
+                if (compare::numbers(*it, *(it + 1)) < 0) {
                         return LisppObject::create_false();
                 }
         }
@@ -256,11 +1299,10 @@ LisppObject operators::greater_eq(std::vector<LisppObject> args)
 }
 
 /// (= <atom-1> ... <atom-n>) -> LisppObject.True | LisppObject.False
-LisppObject operators::equal(std::vector<LisppObject> args)
+LisppObject operators::equal(Arguments args)
 {
         for (auto it = args.begin(); it != args.end() - 1; it++) {
-                LisppObject eq = equal_helper(*it, *(it + 1));
-                if (eq.is_false()) {
+                if (!compare::equal(*it, *(it + 1))) {
                         return LisppObject::create_false();
                 }
         }
@@ -268,81 +1310,152 @@ LisppObject operators::equal(std::vector<LisppObject> args)
 }
 
 /// (!= <atom-1> ... <atom-n>) -> LisppObject.True | LisppObject.False
-LisppObject operators::not_equal(std::vector<LisppObject> args)
+LisppObject operators::not_equal(Arguments args)
 {
-        return _not({equal(args)});
+        return LisppObject::create_boolean(equal(std::move(args)).is_false());
 }
 
 // Type Predicates
 
 /// (list? <list>) -> LisppObject.True | LisppObject.False
-LisppObject operators::is_list(std::vector<LisppObject> args)
+LisppObject operators::is_list(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(list? <list>)", 1, args.size());
         }
-        auto list = args.front();
-        return list.is_list() ? LisppObject::create_true()
-                              : LisppObject::create_false();
+        const auto& list = args.front();
+        return LisppObject::create_boolean(list.is_list());
+}
+
+/// (pair? <any>) -> LisppObject.True | LisppObject.False
+LisppObject operators::is_pair(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(pair? <any>)", 1, args.size());
+        }
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_pair());
+}
+
+/// (map? <any>) -> LisppObject.True | LisppObject.False
+LisppObject operators::is_map(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(map? <any>)", 1, args.size());
+        }
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_map());
+}
+
+/// (sorted-map? <any>) -> LisppObject.True | LisppObject.False
+LisppObject operators::is_sorted_map(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(sorted-map? <any>)", 1, args.size());
+        }
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_sorted_map());
+}
+
+/// (f64vec? <any>) -> LisppObject.True | LisppObject.False
+LisppObject operators::is_f64vec(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(f64vec? <any>)", 1, args.size());
+        }
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_f64vec());
+}
+
+/// (bytes? <any>) -> LisppObject.True | LisppObject.False
+LisppObject operators::is_bytes(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(bytes? <any>)", 1, args.size());
+        }
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_bytes());
+}
+
+/// (decimal? <any>) -> LisppObject.True | LisppObject.False
+LisppObject operators::is_decimal(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(decimal? <any>)", 1, args.size());
+        }
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_decimal());
+}
+
+/// (string? <any>) -> LisppObject.True | LisppObject.False
+LisppObject operators::is_string(Arguments args)
+{
+        if (args.size() != 1) {
+                throw exception::invalid_arg_size(
+                        "(string? <any>)", 1, args.size());
+        }
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_string());
 }
 
 /// (nil? <any>) -> LisppObject.True | LisppObject.False
-LisppObject operators::is_nil(std::vector<LisppObject> args)
+LisppObject operators::is_nil(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(nil? <any>)", 1, args.size());
         }
-        auto any = args.front();
-        return any.is_nil() ? LisppObject::create_true()
-                            : LisppObject::create_false();
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_nil());
 }
 
 /// (true? <any>) -> LisppObject.True | LisppObject.False
-LisppObject operators::is_true(std::vector<LisppObject> args)
+LisppObject operators::is_true(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(true? <any>)", 1, args.size());
         }
-        auto any = args.front();
-        return any.is_true() ? LisppObject::create_true()
-                             : LisppObject::create_false();
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_true());
 }
 
 /// (false? <any>) -> LisppObject.True | LisppObject.False
-LisppObject operators::is_false(std::vector<LisppObject> args)
+LisppObject operators::is_false(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(false? <any>)", 1, args.size());
         }
-        auto any = args.front();
-        return any.is_false() ? LisppObject::create_true()
-                              : LisppObject::create_false();
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_false());
 }
 
 /// (symbol? <any>) -> LisppObject.True | LisppObject.False
-LisppObject operators::is_symbol(std::vector<LisppObject> args)
+LisppObject operators::is_symbol(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(symbol? <any>)", 1, args.size());
         }
-        auto any = args.front();
-        return any.is_symbol() ? LisppObject::create_true()
-                               : LisppObject::create_false();
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_symbol());
 }
 
 /// (number? <any>) -> LisppObject.True | LisppObject.False
-LisppObject operators::is_number(std::vector<LisppObject> args)
+LisppObject operators::is_number(Arguments args)
 {
         if (args.size() != 1) {
                 throw exception::invalid_arg_size(
                         "(number? <any>)", 1, args.size());
         }
-        auto any = args.front();
-        return any.is_number() ? LisppObject::create_true()
-                               : LisppObject::create_false();
+        const auto& any = args.front();
+        return LisppObject::create_boolean(any.is_number());
 }
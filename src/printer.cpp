@@ -4,20 +4,46 @@ using namespace type;
 
 namespace {
 
+std::string ast_to_string(const LisppObject& ast);
+
+// Prints a hash or sorted map as `{k1 v1, k2 v2}`, in iteration order.
+template <typename Entries>
+std::string map_to_string(const Entries& map)
+{
+        std::string result{"{"};
+        map.for_each([&](const LisppObject& key, const LisppObject& value) {
+                if (result.size() > 1) {
+                        result += ", ";
+                }
+                result += ast_to_string(key) + " " + ast_to_string(value);
+        });
+        return result + "}";
+}
+
 std::string ast_to_string(const LisppObject& ast)
 {
         std::string result;
         std::string padding{" "};
 
-        switch (ast.type) {
+        switch (ast.type()) {
         case Type::String:
-                result = ast.string;
+                result = ast.string();
                 break;
         case Type::Number:
-                result = std::to_string(ast.number);
+                result = std::to_string(ast.number());
+                break;
+        case Type::Integer:
+                result = std::to_string(ast.integer());
+                break;
+        case Type::Bignum:
+                result = ast.bigint().to_string();
+                break;
+        case Type::Decimal:
+        case Type::BigDecimal:
+                result = decimal::to_string(ast.decimal()) + "M";
                 break;
         case Type::Symbol:
-                result = ast.symbol;
+                result = ast.symbol();
                 break;
         case Type::True:
                 result = "true";
@@ -28,19 +54,72 @@ std::string ast_to_string(const LisppObject& ast)
         case Type::Nil:
                 result = "nil";
                 break;
+        case Type::Builtin:
         case Type::Function:
                 result = "#<function>";
                 break;
+        case Type::Transient:
+                result = "#<transient>";
+                break;
+        case Type::Pair: {
+                result += "(";
+                const LisppObject* cell = &ast;
+                for (; cell->is_pair(); cell = &cell->cdr()) {
+                        if (cell != &ast) {
+                                result += padding;
+                        }
+                        result += ast_to_string(cell->car());
+                }
+                if (cell->is_list()) {
+                        for (const auto& item : cell->items()) {
+                                result += padding + ast_to_string(item);
+                        }
+                }
+                else if (!cell->is_nil()) {
+                        result += " . " + ast_to_string(*cell);
+                }
+                result += ")";
+                break;
+        }
         case Type::List:
                 result += "(";
-                for (auto i = ast.items.begin(); i != ast.items.end(); ++i) {
-                        if (std::next(i) == ast.items.end()) {
+                for (auto i = ast.items().begin(); i != ast.items().end(); ++i) {
+                        if (std::next(i) == ast.items().end()) {
                                 padding = "";
                         }
                         result += ast_to_string(*i) + padding;
                 }
                 result += ")";
                 break;
+        case Type::Map:
+                result = map_to_string(ast.map());
+                break;
+        case Type::SortedMap:
+                result = map_to_string(ast.sorted_map());
+                break;
+        case Type::Bytes: {
+                static const char digits[] = "0123456789abcdef";
+                result += "#bytes(";
+                for (size_t i = 0; i < ast.bytes().size(); i++) {
+                        if (i > 0) {
+                                result += padding;
+                        }
+                        result += digits[ast.bytes()[i] >> 4];
+                        result += digits[ast.bytes()[i] & 0xf];
+                }
+                result += ")";
+                break;
+        }
+        case Type::F64Vec:
+                result += "#f64(";
+                for (size_t i = 0; i < ast.f64vec().size(); i++) {
+                        if (i > 0) {
+                                result += padding;
+                        }
+                        result += std::to_string(ast.f64vec()[i]);
+                }
+                result += ")";
+                break;
         }
         return result;
 }
@@ -0,0 +1,85 @@
+#include "profiler.h"
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Estimated allocations under one stack.
+struct Totals {
+        double bytes = 0;
+        double count = 0;
+};
+
+size_t interval = 0;
+std::map<std::vector<symbols::SymbolId>, Totals> samples;
+// Seeded alike on every run, so a profile can be reproduced.
+std::mt19937_64 random_bytes;
+
+// Sample points fall at random over the allocated bytes, on average one
+// every `interval`, so the distance to the next is exponential.
+int64_t next_distance()
+{
+        std::exponential_distribution<double> distance{1.0 / interval};
+        return static_cast<int64_t>(distance(random_bytes)) + 1;
+}
+
+} // namespace
+
+void profiler::start(size_t sample_bytes)
+{
+        samples.clear();
+        interval = sample_bytes;
+        random_bytes.seed(std::mt19937_64::default_seed);
+        bytes_until_sample = running() ? next_distance()
+                                       : std::numeric_limits<int64_t>::max();
+}
+
+bool profiler::running() { return interval != 0; }
+
+void profiler::sample(size_t size)
+{
+        if (!running()) {
+                bytes_until_sample = std::numeric_limits<int64_t>::max();
+                return;
+        }
+        // Further sample points within this allocation are skipped: it is
+        // taken once, weighted by the chance that any point fell in it.
+        while (bytes_until_sample < 0) {
+                bytes_until_sample += next_distance();
+        }
+        double taken = 1 - std::exp(-static_cast<double>(size) / interval);
+        Totals& totals = samples[calls];
+        totals.bytes += size / taken;
+        totals.count += 1 / taken;
+}
+
+std::string profiler::report(Weight weight)
+{
+        std::ostringstream report;
+        for (const auto& [stack, totals] : samples) {
+                report << "toplevel";
+                for (auto name : stack) {
+                        report << ';' << symbols::name(name);
+                }
+                double total =
+                    weight == Weight::bytes ? totals.bytes : totals.count;
+                report << ' ' << std::llround(total) << '\n';
+        }
+        return report.str();
+}
+
+void profiler::write(const std::string& path)
+{
+        std::ofstream file{path};
+        file << report();
+        if (!file) {
+                throw std::runtime_error(
+                    "\n;Could not write the allocation profile to " + path +
+                    ".\n");
+        }
+}
@@ -4,10 +4,10 @@ using namespace type;
 
 namespace {
 
-std::optional<double> token_to_number(const std::string& token)
+std::optional<double> token_to_number(std::string_view token)
 {
         // TODO: Make `number` double-type when GCC/Clang adds support for
-        // floating-point `std::from_chars`. This will make `LisppObject.number`
+        // floating-point `std::from_chars`. This will make `LisppObject::number()`
         // floating-point compatible.
         // double number = 0.0;
         // auto data = token.data();
@@ -19,7 +19,7 @@ std::optional<double> token_to_number(const std::string& token)
         // Temporary Hack.
         std::optional<double> number = std::nullopt;
         try {
-                number = std::stod(token.c_str());
+                number = std::stod(std::string{token});
         }
         catch (const std::invalid_argument& ia) {
                 /// Ignore the exception.
@@ -27,22 +27,67 @@ std::optional<double> token_to_number(const std::string& token)
         return number;
 }
 
-std::string clean(const std::string& text)
+// Integer literals (no decimal point) are read exactly: as an immediate when
+// they fit in 64 bits and as a bignum otherwise.
+std::optional<LisppObject> token_to_integer(std::string_view token)
 {
-        std::string clean{text};
-        clean.erase(std::remove(clean.begin(), clean.end(), ','), clean.end());
-        return clean;
+        int64_t integer = 0;
+        auto first = token.data();
+        auto last = token.data() + token.size();
+        auto [p, ec] = std::from_chars(first, last, integer);
+        if (ec == std::errc::result_out_of_range) {
+                auto bigint = bignum::BigInt::from_string(token);
+                if (bigint.has_value()) {
+                        return LisppObject::create_bignum(*bigint);
+                }
+        }
+        if (ec != std::errc() || p != last) {
+                return std::nullopt;
+        }
+        return LisppObject::create_integer(integer);
+}
+
+// Decimal literals are digits with an optional point and an `M` suffix,
+// e.g. 12.34M.
+std::optional<LisppObject> token_to_decimal(std::string_view token)
+{
+        if (token.size() < 2 || token.back() != 'M') {
+                return std::nullopt;
+        }
+        auto value = decimal::from_string(token.substr(0, token.size() - 1));
+        if (!value.has_value()) {
+                return std::nullopt;
+        }
+        return LisppObject::create_decimal(std::move(*value));
 }
 
-std::vector<std::string> split(const std::string& text,
-                               const std::string regex_str)
+// Commas are whitespace, except inside string literals. The result is a
+// copy in the current arena.
+std::string_view clean(std::string_view text)
 {
-        std::regex regex{regex_str};
-        std::sregex_token_iterator iter(text.begin(), text.end(), regex);
-        std::sregex_token_iterator end;
-        std::vector<std::string> split;
+        auto* clean =
+            static_cast<char*>(arena::current().allocate(text.size(), 1));
+        size_t size = 0;
+        bool quoted = false;
+        for (char c : text) {
+                quoted ^= c == '"';
+                if (c != ',' || quoted) {
+                        clean[size++] = c;
+                }
+        }
+        return {clean, size};
+}
+
+Reader::Tokens split(std::string_view text)
+{
+        static const std::regex regex{syntax::grammar};
+        std::cregex_iterator iter(text.data(), text.data() + text.size(),
+                                  regex);
+        std::cregex_iterator end;
+        Reader::Tokens split;
         for (; iter != end; iter++) {
-                split.push_back(*iter);
+                const auto& match = (*iter)[0];
+                split.emplace_back(match.first, match.length());
         }
         return split;
 }
@@ -52,18 +97,16 @@ std::vector<std::string> split(const std::string& text,
 // Parse a `program` into `Lispp` internal representation.
 LisppObject Reader::read(const std::string& program)
 {
-        auto tokens = tokenize(program);
-        auto reader = Reader(tokens);
+        arena::Scope scope;
+        auto reader = Reader(tokenize(program));
         auto form = reader.read_form();
         return form;
 }
 
 // Simple lexical analysis based on splitting.
-std::vector<std::string> Reader::tokenize(const std::string& text)
+Reader::Tokens Reader::tokenize(std::string_view text)
 {
-        std::string cleansed_text{clean(text)};
-        auto tokens = split(cleansed_text, syntax::grammar);
-        return tokens;
+        return split(clean(text));
 }
 
 // Read a `Lispp` expression from the internal tokenized string.
@@ -72,7 +115,7 @@ LisppObject Reader::read_form()
         if (tokens.empty()) {
                 throw std::runtime_error("\n;Unexpected EOF.\n");
         }
-        std::string token = peek().value_or("");
+        std::string_view token = peek().value_or("");
         if (syntax::is_list_delimited(token)) {
                 return read_list();
         }
@@ -86,10 +129,9 @@ LisppObject Reader::read_form()
 
 LisppObject Reader::read_list()
 {
-        auto list = LisppObject::create_list({});
+        SmallVector<LisppObject, 8> items;
         while (next().has_value() && peek().value_or(")") != ")") {
-                auto form = read_form();
-                list.items.push_back(form);
+                items.push_back(read_form());
         }
         if (!peek().has_value()) {
                 /* Note: Remove after allowing <enter>
@@ -97,14 +139,19 @@ LisppObject Reader::read_list()
                  */
                 throw std::runtime_error("\n;Unbalanced parentheses.\n");
         }
-        return list;
+        return LisppObject::create_list(List{items.data(), items.size()});
 }
 
 LisppObject Reader::read_string()
 {
-        std::string str = peek().value_or("");
-        while (peek().value().back() != '"' && next().has_value()) {
-                str += " " + peek().value();
+        std::string_view str = peek().value_or("");
+        if (str.back() != '"') {
+                std::string joined{str};
+                while (peek().value().back() != '"' && next().has_value()) {
+                        joined += " ";
+                        joined += peek().value();
+                }
+                str = arena::copy(joined);
         }
         if (str.back() != '"') {
                 /* Note: Remove after allowing <enter>
@@ -112,14 +159,33 @@ LisppObject Reader::read_string()
                  */
                 throw std::runtime_error("\n;Unbalanced string.\n");
         }
-        str = str.substr(1, str.length() - 2); // Remove string quotes: ""
-        return LisppObject::create_string(str);
+        auto [constant, inserted] = constants.try_emplace(str);
+        if (inserted) {
+                // Remove string quotes: ""
+                constant->second =
+                    LisppObject::create_string(str.substr(1, str.length() - 2));
+        }
+        return constant->second;
 }
 
 LisppObject Reader::read_atom()
 {
-        std::string token = peek().value_or("");
-        if (token_to_number(token) != std::nullopt) {
+        std::string_view token = peek().value_or("");
+        if (auto integer = token_to_integer(token)) {
+                if (integer->is_bignum()) {
+                        return constants.try_emplace(token, *integer)
+                            .first->second;
+                }
+                return *integer;
+        }
+        else if (auto decimal = token_to_decimal(token)) {
+                if (decimal->type() == Type::BigDecimal) {
+                        return constants.try_emplace(token, *decimal)
+                            .first->second;
+                }
+                return *decimal;
+        }
+        else if (token_to_number(token) != std::nullopt) {
                 auto num = token_to_number(token).value();
                 return LisppObject::create_number(num);
         }
@@ -137,7 +203,7 @@ LisppObject Reader::read_atom()
         }
 }
 
-std::optional<std::string> Reader::next()
+std::optional<std::string_view> Reader::next()
 {
         if (out_of_bounds()) {
                 return std::nullopt;
@@ -145,7 +211,7 @@ std::optional<std::string> Reader::next()
         return tokens.at(position++);
 }
 
-std::optional<std::string> Reader::peek()
+std::optional<std::string_view> Reader::peek()
 {
         if (out_of_bounds()) {
                 return std::nullopt;
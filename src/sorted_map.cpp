@@ -0,0 +1,334 @@
+#include "sorted_map.h"
+
+#include <iterator>
+
+#include "compare.h"
+
+using namespace type;
+
+namespace {
+
+constexpr size_t degree = SortedMap::degree;
+
+// Returns the node in `slot` for mutation, first replacing it with a fresh
+// or copied node unless it is owned exclusively.
+SortedNode* unique_node(Ref<SortedNode>& slot)
+{
+        if (!slot) {
+                slot = Ref<SortedNode>{new SortedNode};
+        }
+        else if (!slot.unique()) {
+                slot = Ref<SortedNode>{new SortedNode{*slot}};
+        }
+        return slot.get();
+}
+
+// Index of the first key in `node` not less than `key`.
+size_t lower_bound(const SortedNode& node, const LisppObject& key)
+{
+        size_t low = 0;
+        size_t high = node.keys.size();
+        while (low < high) {
+                size_t mid = (low + high) / 2;
+                if (compare::order(node.keys[mid], key) < 0) {
+                        low = mid + 1;
+                }
+                else {
+                        high = mid;
+                }
+        }
+        return low;
+}
+
+bool matches(const SortedNode& node, size_t i, const LisppObject& key)
+{
+        return i < node.keys.size() && compare::order(node.keys[i], key) == 0;
+}
+
+// Splits the full child `i` of `parent` around its median key, which moves
+// up into `parent`.
+void split_child(SortedNode& parent, size_t i)
+{
+        SortedNode* child = unique_node(parent.children[i]);
+        Ref<SortedNode> right{new SortedNode};
+        right->keys.assign(std::make_move_iterator(child->keys.begin() + degree),
+                           std::make_move_iterator(child->keys.end()));
+        right->values.assign(
+            std::make_move_iterator(child->values.begin() + degree),
+            std::make_move_iterator(child->values.end()));
+        if (!child->leaf()) {
+                right->children.assign(
+                    std::make_move_iterator(child->children.begin() + degree),
+                    std::make_move_iterator(child->children.end()));
+                child->children.resize(degree);
+        }
+        LisppObject key = std::move(child->keys[degree - 1]);
+        LisppObject value = std::move(child->values[degree - 1]);
+        child->keys.resize(degree - 1);
+        child->values.resize(degree - 1);
+        parent.keys.insert(parent.keys.begin() + i, std::move(key));
+        parent.values.insert(parent.values.begin() + i, std::move(value));
+        parent.children.insert(parent.children.begin() + i + 1,
+                               std::move(right));
+}
+
+// Inserts below a node that is not full, splitting full children on the way
+// down; returns whether the key was new.
+bool insert_nonfull(Ref<SortedNode>& slot, LisppObject& key,
+                    LisppObject& value)
+{
+        SortedNode* node = unique_node(slot);
+        size_t i = lower_bound(*node, key);
+        if (matches(*node, i, key)) {
+                node->values[i] = std::move(value);
+                return false;
+        }
+        if (node->leaf()) {
+                node->keys.insert(node->keys.begin() + i, std::move(key));
+                node->values.insert(node->values.begin() + i, std::move(value));
+                return true;
+        }
+        if (node->children[i]->keys.size() == SortedMap::max_keys) {
+                split_child(*node, i);
+                int order = compare::order(key, node->keys[i]);
+                if (order == 0) {
+                        node->values[i] = std::move(value);
+                        return false;
+                }
+                if (order > 0) {
+                        i++;
+                }
+        }
+        return insert_nonfull(node->children[i], key, value);
+}
+
+// Moves the last entry of child `i - 1` up into `node` and the separator
+// down into child `i`.
+void borrow_left(SortedNode& node, size_t i)
+{
+        SortedNode* child = unique_node(node.children[i]);
+        SortedNode* left = unique_node(node.children[i - 1]);
+        child->keys.insert(child->keys.begin(), std::move(node.keys[i - 1]));
+        child->values.insert(child->values.begin(),
+                             std::move(node.values[i - 1]));
+        node.keys[i - 1] = std::move(left->keys.back());
+        node.values[i - 1] = std::move(left->values.back());
+        left->keys.pop_back();
+        left->values.pop_back();
+        if (!left->leaf()) {
+                child->children.insert(child->children.begin(),
+                                       std::move(left->children.back()));
+                left->children.pop_back();
+        }
+}
+
+// Moves the first entry of child `i + 1` up into `node` and the separator
+// down into child `i`.
+void borrow_right(SortedNode& node, size_t i)
+{
+        SortedNode* child = unique_node(node.children[i]);
+        SortedNode* right = unique_node(node.children[i + 1]);
+        child->keys.push_back(std::move(node.keys[i]));
+        child->values.push_back(std::move(node.values[i]));
+        node.keys[i] = std::move(right->keys.front());
+        node.values[i] = std::move(right->values.front());
+        right->keys.erase(right->keys.begin());
+        right->values.erase(right->values.begin());
+        if (!right->leaf()) {
+                child->children.push_back(std::move(right->children.front()));
+                right->children.erase(right->children.begin());
+        }
+}
+
+// Merges child `i + 1` and the separator between them into child `i`.
+void merge(SortedNode& node, size_t i)
+{
+        SortedNode* left = unique_node(node.children[i]);
+        Ref<SortedNode> right = std::move(node.children[i + 1]);
+        left->keys.push_back(std::move(node.keys[i]));
+        left->values.push_back(std::move(node.values[i]));
+        left->keys.insert(left->keys.end(), right->keys.begin(),
+                          right->keys.end());
+        left->values.insert(left->values.end(), right->values.begin(),
+                            right->values.end());
+        left->children.insert(left->children.end(), right->children.begin(),
+                              right->children.end());
+        node.keys.erase(node.keys.begin() + i);
+        node.values.erase(node.values.begin() + i);
+        node.children.erase(node.children.begin() + i + 1);
+}
+
+// Gives child `i` at least `degree` keys before descending into it;
+// returns the index of the child that now covers its range.
+size_t fill(SortedNode& node, size_t i)
+{
+        if (i > 0 && node.children[i - 1]->keys.size() >= degree) {
+                borrow_left(node, i);
+        }
+        else if (i < node.keys.size() &&
+                 node.children[i + 1]->keys.size() >= degree) {
+                borrow_right(node, i);
+        }
+        else if (i < node.keys.size()) {
+                merge(node, i);
+        }
+        else {
+                merge(node, --i);
+        }
+        return i;
+}
+
+// Removes `key`, which must be present below `slot`. Every node descended
+// into has at least `degree` keys, so removal never underfills it.
+void erase_node(Ref<SortedNode>& slot, const LisppObject& key)
+{
+        SortedNode* node = unique_node(slot);
+        size_t i = lower_bound(*node, key);
+        if (!matches(*node, i, key)) {
+                if (node->children[i]->keys.size() < degree) {
+                        i = fill(*node, i);
+                }
+                erase_node(node->children[i], key);
+                return;
+        }
+        if (node->leaf()) {
+                node->keys.erase(node->keys.begin() + i);
+                node->values.erase(node->values.begin() + i);
+        }
+        else if (node->children[i]->keys.size() >= degree) {
+                // Replace the key with its predecessor, then remove that.
+                const SortedNode* below = node->children[i].get();
+                while (!below->leaf()) {
+                        below = below->children.back().get();
+                }
+                node->keys[i] = below->keys.back();
+                node->values[i] = below->values.back();
+                LisppObject predecessor = node->keys[i];
+                erase_node(node->children[i], predecessor);
+        }
+        else if (node->children[i + 1]->keys.size() >= degree) {
+                const SortedNode* below = node->children[i + 1].get();
+                while (!below->leaf()) {
+                        below = below->children.front().get();
+                }
+                node->keys[i] = below->keys.front();
+                node->values[i] = below->values.front();
+                LisppObject successor = node->keys[i];
+                erase_node(node->children[i + 1], successor);
+        }
+        else {
+                merge(*node, i);
+                erase_node(node->children[i], key);
+        }
+}
+
+// Inserts the entries of `node` with `low <= key < high` into `out`, in
+// order; returns false once past `high`.
+bool collect_range(const SortedNode& node, const LisppObject& low,
+                   const LisppObject& high, SortedMap& out)
+{
+        for (size_t i = lower_bound(node, low);; i++) {
+                if (!node.leaf() &&
+                    !collect_range(*node.children[i], low, high, out)) {
+                        return false;
+                }
+                if (i == node.keys.size()) {
+                        return true;
+                }
+                if (compare::order(node.keys[i], high) >= 0) {
+                        return false;
+                }
+                out.insert(node.keys[i], node.values[i]);
+        }
+}
+
+} // namespace
+
+const LisppObject* SortedMap::find(const LisppObject& key) const
+{
+        const SortedNode* node = root.get();
+        while (node != nullptr) {
+                size_t i = lower_bound(*node, key);
+                if (matches(*node, i, key)) {
+                        return &node->values[i];
+                }
+                node = node->leaf() ? nullptr : node->children[i].get();
+        }
+        return nullptr;
+}
+
+const LisppObject* SortedMap::first_key() const
+{
+        const SortedNode* node = root.get();
+        if (node == nullptr) {
+                return nullptr;
+        }
+        while (!node->leaf()) {
+                node = node->children.front().get();
+        }
+        return &node->keys.front();
+}
+
+const LisppObject* SortedMap::last_key() const
+{
+        const SortedNode* node = root.get();
+        if (node == nullptr) {
+                return nullptr;
+        }
+        while (!node->leaf()) {
+                node = node->children.back().get();
+        }
+        return &node->keys.back();
+}
+
+SortedMap SortedMap::subrange(const LisppObject& low,
+                              const LisppObject& high) const
+{
+        SortedMap range;
+        if (root) {
+                collect_range(*root, low, high, range);
+        }
+        return range;
+}
+
+SortedMap SortedMap::assoc(LisppObject key, LisppObject value) const
+{
+        SortedMap map{*this};
+        map.insert(std::move(key), std::move(value));
+        return map;
+}
+
+SortedMap SortedMap::dissoc(const LisppObject& key) const
+{
+        SortedMap map{*this};
+        map.erase(key);
+        return map;
+}
+
+void SortedMap::insert(LisppObject key, LisppObject value)
+{
+        if (root && root->keys.size() == max_keys) {
+                Ref<SortedNode> grown{new SortedNode};
+                grown->children.push_back(std::move(root));
+                root = std::move(grown);
+                split_child(*root, 0);
+        }
+        if (insert_nonfull(root, key, value)) {
+                count++;
+        }
+}
+
+void SortedMap::erase(const LisppObject& key)
+{
+        if (find(key) == nullptr) {
+                return;
+        }
+        erase_node(root, key);
+        count--;
+        if (root->keys.empty()) {
+                // The root emptied out: drop a level, or the whole tree.
+                Ref<SortedNode> next =
+                    root->leaf() ? Ref<SortedNode>{} : root->children.front();
+                root = std::move(next);
+        }
+}
@@ -0,0 +1,53 @@
+#include "symbols.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+struct InternTable {
+        std::shared_mutex mutex;
+        // A deque never moves its elements, so the views used as keys stay
+        // valid as the table grows.
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, symbols::SymbolId> ids;
+};
+
+InternTable& table()
+{
+        static InternTable table;
+        return table;
+}
+
+} // namespace
+
+symbols::SymbolId symbols::intern(std::string_view name)
+{
+        auto& t = table();
+        {
+                std::shared_lock lock{t.mutex};
+                auto it = t.ids.find(name);
+                if (it != t.ids.end()) {
+                        return it->second;
+                }
+        }
+        std::unique_lock lock{t.mutex};
+        auto it = t.ids.find(name);
+        if (it != t.ids.end()) {
+                return it->second;
+        }
+        auto id = static_cast<SymbolId>(t.names.size());
+        const auto& stored = t.names.emplace_back(name);
+        t.ids.emplace(stored, id);
+        return id;
+}
+
+const std::string& symbols::name(SymbolId id)
+{
+        auto& t = table();
+        std::shared_lock lock{t.mutex};
+        return t.names.at(id);
+}
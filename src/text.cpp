@@ -0,0 +1,107 @@
+#include "text.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace type;
+
+namespace {
+
+// Concatenations up to this length are copied flat: a rope node would cost
+// more than the characters it saves copying.
+constexpr size_t flat_limit = 64;
+
+} // namespace
+
+CharBuffer* CharBuffer::create(size_t size)
+{
+        void* memory = allocate_cell(sizeof(CharBuffer) + size);
+        return ::new (memory) CharBuffer{size};
+}
+
+CharBuffer* CharBuffer::create(std::string_view text)
+{
+        auto* buffer = create(text.size());
+        std::memcpy(buffer->chars(), text.data(), text.size());
+        return buffer;
+}
+
+StringCell* StringCell::create(std::string_view text)
+{
+        return new StringCell{Ref<CharBuffer>{CharBuffer::create(text)}, 0,
+                              text.size()};
+}
+
+StringCell* StringCell::slice(const StringCell& string, size_t start,
+                              size_t end)
+{
+        string.view();
+        return new StringCell{string.buffer, string.offset + start,
+                              end - start};
+}
+
+StringCell* StringCell::concat(StringCell* left, StringCell* right)
+{
+        if (left->length == 0) {
+                return right;
+        }
+        if (right->length == 0) {
+                return left;
+        }
+        size_t length = left->length + right->length;
+        if (length > flat_limit) {
+                return new StringCell{left, right};
+        }
+        Ref<CharBuffer> buffer{CharBuffer::create(length)};
+        std::memcpy(buffer->chars(), left->view().data(), left->length);
+        std::memcpy(buffer->chars() + left->length, right->view().data(),
+                    right->length);
+        return new StringCell{std::move(buffer), 0, length};
+}
+
+StringCell::~StringCell()
+{
+        if (!left) {
+                return;
+        }
+        // A rope built by repeated appends is as deep as it is long, so free
+        // it iteratively: detach the children of each node we are about to
+        // drop, so no destructor ever recurses into another rope.
+        std::vector<Ref<StringCell>> pending;
+        pending.push_back(std::move(left));
+        pending.push_back(std::move(right));
+        while (!pending.empty()) {
+                Ref<StringCell> node = std::move(pending.back());
+                pending.pop_back();
+                if (node.unique() && node->left) {
+                        pending.push_back(std::move(node->left));
+                        pending.push_back(std::move(node->right));
+                }
+        }
+}
+
+void StringCell::flatten() const
+{
+        Ref<CharBuffer> flat{CharBuffer::create(length)};
+        char* out = flat->chars();
+        // Walk the leaves left to right with an explicit stack, since the
+        // rope may be arbitrarily deep.
+        std::vector<const StringCell*> pending{this};
+        while (!pending.empty()) {
+                const StringCell* node = pending.back();
+                pending.pop_back();
+                if (node->buffer) {
+                        std::memcpy(out, node->buffer->chars() + node->offset,
+                                    node->length);
+                        out += node->length;
+                }
+                else {
+                        pending.push_back(node->right.get());
+                        pending.push_back(node->left.get());
+                }
+        }
+        buffer = std::move(flat);
+        offset = 0;
+        left = Ref<StringCell>{};
+        right = Ref<StringCell>{};
+}
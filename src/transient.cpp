@@ -0,0 +1,90 @@
+#include "transient.h"
+
+#include <stdexcept>
+
+using namespace type;
+
+Transient::Transient(const LisppObject& collection) : kind{collection.type()}
+{
+        switch (kind) {
+        case Type::List:
+                list = collection.items();
+                break;
+        case Type::Map:
+                map = collection.map();
+                break;
+        case Type::SortedMap:
+                sorted_map = collection.sorted_map();
+                break;
+        default:
+                throw std::runtime_error(
+                    "\n;(transient <list | map>) expects a list or map.\n");
+        }
+}
+
+void Transient::conj(LisppObject value)
+{
+        check(Type::List);
+        list.push_back(std::move(value));
+}
+
+void Transient::assoc(LisppObject key, LisppObject value)
+{
+        check(kind == Type::SortedMap ? Type::SortedMap : Type::Map);
+        if (kind == Type::SortedMap) {
+                sorted_map.insert(std::move(key), std::move(value));
+        }
+        else {
+                map.insert(std::move(key), std::move(value));
+        }
+}
+
+void Transient::dissoc(const LisppObject& key)
+{
+        check(kind == Type::SortedMap ? Type::SortedMap : Type::Map);
+        if (kind == Type::SortedMap) {
+                sorted_map.erase(key);
+        }
+        else {
+                map.erase(key);
+        }
+}
+
+size_t Transient::size() const
+{
+        check(kind);
+        switch (kind) {
+        case Type::List:
+                return list.size();
+        case Type::Map:
+                return map.size();
+        default:
+                return sorted_map.size();
+        }
+}
+
+LisppObject Transient::persistent()
+{
+        check(kind);
+        editable = false;
+        switch (kind) {
+        case Type::List:
+                return LisppObject::create_list(std::move(list));
+        case Type::Map:
+                return LisppObject::create_map(std::move(map));
+        default:
+                return LisppObject::create_sorted_map(std::move(sorted_map));
+        }
+}
+
+void Transient::check(Type expected) const
+{
+        if (!editable) {
+                throw std::runtime_error(
+                    "\n;Transient used after (persistent! <transient>).\n");
+        }
+        if (kind != expected) {
+                throw std::runtime_error("\n;Cannot edit a transient " +
+                                         types[kind] + " this way.\n");
+        }
+}
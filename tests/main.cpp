@@ -1,8 +1,14 @@
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
+
+#include <cstdio>
+#include <fstream>
 
 #include "catch.hpp"
 #include "evaluator.h"
+#include "footprint.h"
 #include "frame.h"
+#include "gc.h"
 #include "interpreter.h"
 
 // Keyword Operations Tests
@@ -56,12 +62,76 @@ TEST_CASE("Arithmetic", "[arithmetic]")
         {
                 auto sum = "(+ 12 -1)";
                 auto result = interpreter::rep(sum, global_frame);
-                auto expected = "11.000000";
+                auto expected = "11";
                 REQUIRE(result == expected);
         }
 }
 
+TEST_CASE("Integer Arithmetic", "[arithmetic]")
+{
+        Frame global_frame{Frame::global()};
+        REQUIRE(interpreter::rep("(+ 1 2)", global_frame) == "3");
+        REQUIRE(interpreter::rep("(+ 1 2.5)", global_frame) == "3.500000");
+        REQUIRE(interpreter::rep("(/ 8 2)", global_frame) == "4");
+        REQUIRE(interpreter::rep("(/ 7 2)", global_frame) == "3.500000");
+        REQUIRE(interpreter::rep("(+ 9007199254740993 0)", global_frame) ==
+                "9007199254740993");
+        REQUIRE(interpreter::rep("(< 1 2.5 3)", global_frame) == "true");
+        REQUIRE(interpreter::rep("(= 2 2.0)", global_frame) == "true");
+}
+
+TEST_CASE("Bignum Arithmetic", "[arithmetic]")
+{
+        Frame global_frame{Frame::global()};
+        REQUIRE(interpreter::rep("(* 4611686018427387904 4)", global_frame) ==
+                "18446744073709551616");
+        REQUIRE(interpreter::rep("(- (* 4611686018427387904 4) "
+                                 "18446744073709551615)",
+                                 global_frame) == "1");
+        REQUIRE(interpreter::rep("(- -9223372036854775807 2)", global_frame) ==
+                "-9223372036854775809");
+        interpreter::rep("(def fact (fn (n) (if (< n 2) 1 (* n (fact (- n 1))))))",
+                         global_frame);
+        REQUIRE(interpreter::rep("(fact 30)", global_frame) ==
+                "265252859812191058636308480000000");
+        REQUIRE(interpreter::rep("(< (fact 21) (fact 22))", global_frame) ==
+                "true");
+        // Large enough operands to take the Karatsuba path.
+        interpreter::rep("(def big (fact 400))", global_frame);
+        REQUIRE(interpreter::rep("(= (/ (* big big) big) big)", global_frame) ==
+                "true");
+}
+
 // Relational Tests
+TEST_CASE("Decimal Arithmetic", "[arithmetic]")
+{
+        Frame global_frame{Frame::global()};
+        REQUIRE(interpreter::rep("(+ 0.1M 0.2M)", global_frame) == "0.3M");
+        REQUIRE(interpreter::rep("(- 12.34M 0.66M)", global_frame) ==
+                "11.68M");
+        REQUIRE(interpreter::rep("(* 1.10M 3)", global_frame) == "3.30M");
+        REQUIRE(interpreter::rep("(/ 10.00M 3)", global_frame) == "3.33M");
+        REQUIRE(interpreter::rep("(+ 1.5M 1.0)", global_frame) == "2.500000");
+        REQUIRE(interpreter::rep("(decimal-div 2.5M 1 0 \"half-even\")",
+                                 global_frame) == "2M");
+        REQUIRE(interpreter::rep("(decimal-div 2.5M 1 0 \"half-up\")",
+                                 global_frame) == "3M");
+        REQUIRE(interpreter::rep("(decimal-div -1M 3 2 \"floor\")",
+                                 global_frame) == "-0.34M");
+        REQUIRE(interpreter::rep("(decimal 2.675 2 \"half-up\")",
+                                 global_frame) == "2.68M");
+        REQUIRE(interpreter::rep("(* 99999999999999999.99M 1000)",
+                                 global_frame) == "99999999999999999990.00M");
+        REQUIRE(interpreter::rep("(- 100000000000000000000.01M 0.01M)",
+                                 global_frame) == "100000000000000000000.00M");
+        REQUIRE(interpreter::rep("(= 1.10M 1.1M 1.1)", global_frame) ==
+                "true");
+        REQUIRE(interpreter::rep("(< 1.99M 2 2.01M)", global_frame) ==
+                "true");
+        REQUIRE(interpreter::rep("(decimal? 1M)", global_frame) == "true");
+        REQUIRE_THROWS(interpreter::rep("(/ 1M 0M)", global_frame));
+}
+
 TEST_CASE("Relational", "[comparator]")
 {
         Frame global_frame{Frame::global()};
@@ -78,3 +148,534 @@ TEST_CASE("Relational", "[comparator]")
                 REQUIRE(result == expected);
         }
 }
+
+// List Processing Tests
+TEST_CASE("List Processing", "[list]")
+{
+        Frame global_frame{Frame::global()};
+        {
+                interpreter::rep("(def xs (list \"a\" (list 1 2) 3))",
+                                 global_frame);
+                auto result = interpreter::rep("(first (rest xs))", global_frame);
+                auto expected = "(1 2)";
+                REQUIRE(result == expected);
+        }
+        {
+                auto result = interpreter::rep("xs", global_frame);
+                auto expected = "(a (1 2) 3)";
+                REQUIRE(result == expected);
+        }
+}
+
+TEST_CASE("Persistent Lists", "[list]")
+{
+        Frame global_frame{Frame::global()};
+        interpreter::rep("(def build (fn (n acc) (if (= n 0) acc "
+                         "(build (- n 1) (conj acc n)))))",
+                         global_frame);
+        interpreter::rep("(def xs (build 2000 (list)))", global_frame);
+        REQUIRE(interpreter::rep("(count xs)", global_frame) == "2000");
+        REQUIRE(interpreter::rep("(nth xs 0)", global_frame) == "2000");
+        REQUIRE(interpreter::rep("(nth xs 1999)", global_frame) == "1");
+        REQUIRE(interpreter::rep("(nth (rest xs) 1000)", global_frame) == "999");
+        REQUIRE(interpreter::rep("(count (rest (rest xs)))", global_frame) ==
+                "1998");
+        // conj leaves the original list untouched.
+        interpreter::rep("(def ys (conj xs 0))", global_frame);
+        REQUIRE(interpreter::rep("(count xs)", global_frame) == "2000");
+        REQUIRE(interpreter::rep("(nth ys 2000)", global_frame) == "0");
+        REQUIRE(interpreter::rep("(= (list 1 2) (list 1))", global_frame) ==
+                "false");
+        REQUIRE_THROWS(interpreter::rep("(nth xs 2000)", global_frame));
+}
+
+TEST_CASE("Cons Cells", "[list]")
+{
+        Frame global_frame{Frame::global()};
+        REQUIRE(interpreter::rep("(cons 1 (cons 2 nil))", global_frame) ==
+                "(1 2)");
+        REQUIRE(interpreter::rep("(cons 1 2)", global_frame) == "(1 . 2)");
+        REQUIRE(interpreter::rep("(cons 1 (list 2 3))", global_frame) ==
+                "(1 2 3)");
+        interpreter::rep("(def build (fn (n acc) (if (= n 0) acc "
+                         "(build (- n 1) (cons n acc)))))",
+                         global_frame);
+        interpreter::rep("(def sum (fn (xs acc) (if (empty? xs) acc "
+                         "(sum (rest xs) (+ acc (first xs))))))",
+                         global_frame);
+        interpreter::rep("(def xs (build 1000 nil))", global_frame);
+        REQUIRE(interpreter::rep("(count xs)", global_frame) == "1000");
+        REQUIRE(interpreter::rep("(sum xs 0)", global_frame) == "500500");
+        REQUIRE(interpreter::rep("(car (cdr xs))", global_frame) == "2");
+        REQUIRE(interpreter::rep("(= xs (build 1000 nil))", global_frame) ==
+                "true");
+        REQUIRE(interpreter::rep("(pair? xs)", global_frame) == "true");
+}
+
+// Symbol Tests
+TEST_CASE("Symbol Interning", "[symbol]")
+{
+        REQUIRE(symbols::intern("hello") == symbols::intern("hello"));
+        REQUIRE(symbols::intern("hello") != symbols::intern("world"));
+        REQUIRE(symbols::name(symbols::intern("hello")) == "hello");
+
+        Frame global_frame{Frame::global()};
+        {
+                interpreter::rep("(def x 2)", global_frame);
+                auto result = interpreter::rep("(let (y x) (* x y))", global_frame);
+                auto expected = "4";
+                REQUIRE(result == expected);
+        }
+        REQUIRE_THROWS_AS(interpreter::rep("unbound", global_frame),
+                          exception::unbound_symbol_error);
+}
+
+// String Tests
+TEST_CASE("Strings", "[string]")
+{
+        Frame global_frame{Frame::global()};
+        {
+                auto s = type::LisppObject::create_string("shared payload");
+                auto copy = s;
+                REQUIRE(copy.same_cell(s));
+                REQUIRE(copy.string() == "shared payload");
+        }
+        {
+                interpreter::rep("(def s \"hello world\")", global_frame);
+                auto result = interpreter::rep("(= s s)", global_frame);
+                REQUIRE(result == "true");
+        }
+        {
+                auto result = interpreter::rep("(= s \"hello worle\")", global_frame);
+                REQUIRE(result == "false");
+        }
+}
+
+TEST_CASE("String Slices and Ropes", "[string]")
+{
+        Frame global_frame{Frame::global()};
+        interpreter::rep("(def s \"hello, world\")", global_frame);
+        REQUIRE(interpreter::rep("(string-length s)", global_frame) == "12");
+        REQUIRE(interpreter::rep("(substring s 7)", global_frame) == "world");
+        REQUIRE(interpreter::rep("(substring (substring s 7) 1 3)",
+                                 global_frame) == "or");
+        REQUIRE_THROWS(interpreter::rep("(substring s 3 20)", global_frame));
+        REQUIRE(interpreter::rep("(string-append \"ab\" \"\" \"cd\")",
+                                 global_frame) == "abcd");
+        REQUIRE(interpreter::rep("(str \"n = \" 3 \", d = \" 1.50M)",
+                                 global_frame) == "n = 3, d = 1.50M");
+        {
+                auto piece = type::LisppObject::create_string(
+                    "a line of generated report text\n");
+                auto report = type::LisppObject::create_string("");
+                for (int i = 0; i < 100000; i++) {
+                        report = type::LisppObject::create_concat(report,
+                                                                  piece);
+                }
+                REQUIRE(report.string_size() == 3200000);
+                auto tail = type::LisppObject::create_substring(
+                    report, 3199968, 3200000);
+                REQUIRE(tail.string() == piece.string());
+                REQUIRE(compare::equal(tail, piece));
+        }
+}
+
+TEST_CASE("Hash Maps", "[map]")
+{
+        Frame global_frame{Frame::global()};
+        interpreter::rep("(def m (hash-map 1 10 2 20))", global_frame);
+        REQUIRE(interpreter::rep("(get m 1)", global_frame) == "10");
+        REQUIRE(interpreter::rep("(get m 2.0)", global_frame) == "20");
+        REQUIRE(interpreter::rep("(get m 3)", global_frame) == "nil");
+        REQUIRE(interpreter::rep("(get m 3 0)", global_frame) == "0");
+        REQUIRE(interpreter::rep("(count (assoc m 1 11))", global_frame) ==
+                "2");
+        REQUIRE(interpreter::rep("(get (assoc m 1 11) 1)", global_frame) ==
+                "11");
+        REQUIRE(interpreter::rep("(contains? (dissoc m 1) 1)", global_frame) ==
+                "false");
+        REQUIRE(interpreter::rep("(get m 1)", global_frame) == "10");
+        REQUIRE(interpreter::rep("(= m (hash-map 2 20 1 10))", global_frame) ==
+                "true");
+        REQUIRE(interpreter::rep("(map? m)", global_frame) == "true");
+        interpreter::rep("(def fill (fn (n acc) (if (= n 0) acc "
+                         "(fill (- n 1) (assoc acc n (* n n))))))",
+                         global_frame);
+        interpreter::rep("(def drain (fn (n acc) (if (= n 0) acc "
+                         "(drain (- n 2) (dissoc acc n)))))",
+                         global_frame);
+        interpreter::rep("(def big (fill 2000 (hash-map)))", global_frame);
+        REQUIRE(interpreter::rep("(count big)", global_frame) == "2000");
+        REQUIRE(interpreter::rep("(get big 1999)", global_frame) == "3996001");
+        interpreter::rep("(def half (drain 2000 big))", global_frame);
+        REQUIRE(interpreter::rep("(count half)", global_frame) == "1000");
+        REQUIRE(interpreter::rep("(get half 1000)", global_frame) == "nil");
+        REQUIRE(interpreter::rep("(get half 999)", global_frame) == "998001");
+        REQUIRE(interpreter::rep("(count (keys big))", global_frame) == "2000");
+        REQUIRE(interpreter::rep("(empty? (dissoc (hash-map 1 2) 1))",
+                                 global_frame) == "true");
+}
+
+TEST_CASE("Sorted Maps", "[map]")
+{
+        Frame global_frame{Frame::global()};
+        interpreter::rep("(def m (sorted-map 3 30 1 10 2 20))", global_frame);
+        REQUIRE(interpreter::rep("m", global_frame) == "{1 10, 2 20, 3 30}");
+        REQUIRE(interpreter::rep("(sorted-get m 2)", global_frame) == "20");
+        REQUIRE(interpreter::rep("(sorted-get m 4 0)", global_frame) == "0");
+        REQUIRE(interpreter::rep("(first-key m)", global_frame) == "1");
+        REQUIRE(interpreter::rep("(last-key m)", global_frame) == "3");
+        REQUIRE(interpreter::rep("(keys (assoc m 0 0))", global_frame) ==
+                "(0 1 2 3)");
+        REQUIRE(interpreter::rep("(= m (sorted-map 1 10 2 20 3 30))",
+                                 global_frame) == "true");
+        REQUIRE(interpreter::rep("(first-key (sorted-map))", global_frame) ==
+                "nil");
+        interpreter::rep("(def fill (fn (n acc) (if (= n 0) acc "
+                         "(fill (- n 1) (assoc acc n (* n n))))))",
+                         global_frame);
+        interpreter::rep("(def drain (fn (n acc) (if (= n 0) acc "
+                         "(drain (- n 2) (dissoc acc n)))))",
+                         global_frame);
+        interpreter::rep("(def big (fill 2000 (sorted-map)))", global_frame);
+        REQUIRE(interpreter::rep("(count big)", global_frame) == "2000");
+        REQUIRE(interpreter::rep("(last-key big)", global_frame) == "2000");
+        REQUIRE(interpreter::rep("(keys (subrange big 100 105))",
+                                 global_frame) == "(100 101 102 103 104)");
+        interpreter::rep("(def half (drain 2000 big))", global_frame);
+        REQUIRE(interpreter::rep("(count half)", global_frame) == "1000");
+        REQUIRE(interpreter::rep("(last-key half)", global_frame) == "1999");
+        REQUIRE(interpreter::rep("(vals (subrange half 10 16))",
+                                 global_frame) == "(121 169 225)");
+        REQUIRE(interpreter::rep("(count big)", global_frame) == "2000");
+}
+
+TEST_CASE("Transients", "[transient]")
+{
+        Frame global_frame{Frame::global()};
+        interpreter::rep("(def xs (list 1 2))", global_frame);
+        interpreter::rep("(def t (transient xs))", global_frame);
+        interpreter::rep("(conj! t 3 4)", global_frame);
+        REQUIRE(interpreter::rep("(count t)", global_frame) == "4");
+        REQUIRE(interpreter::rep("(persistent! t)", global_frame) ==
+                "(1 2 3 4)");
+        REQUIRE(interpreter::rep("xs", global_frame) == "(1 2)");
+        REQUIRE_THROWS(interpreter::rep("(conj! t 5)", global_frame));
+        REQUIRE(interpreter::rep(
+                    "(persistent! (dissoc! (assoc! (transient (sorted-map)) "
+                    "2 20 1 10 3 30) 3))",
+                    global_frame) == "{1 10, 2 20}");
+        REQUIRE_THROWS(
+            interpreter::rep("(conj! (transient (hash-map)) 1)", global_frame));
+        {
+                auto builder = operators::transient(
+                    {type::LisppObject::create_map(type::Map{})});
+                for (int64_t i = 0; i < 10000; i++) {
+                        auto key = type::LisppObject::create_integer(i);
+                        builder = operators::assoc_in_place(
+                            {builder, key, key});
+                }
+                auto map = operators::persistent({builder});
+                REQUIRE(map.map().size() == 10000);
+                REQUIRE(map.map().find(type::LisppObject::create_integer(
+                            9999)) != nullptr);
+        }
+}
+
+TEST_CASE("Unboxed Vectors", "[f64vec]")
+{
+        Frame global_frame{Frame::global()};
+        interpreter::rep("(def v (f64vec (list 1 2.5 3)))", global_frame);
+        REQUIRE(interpreter::rep("(count v)", global_frame) == "3");
+        REQUIRE(interpreter::rep("(f64vec-get v 1)", global_frame) ==
+                "2.500000");
+        REQUIRE(interpreter::rep("(f64vec->list (f64vec-set v 0 9))",
+                                 global_frame) ==
+                "(9.000000 2.500000 3.000000)");
+        REQUIRE(interpreter::rep("(f64vec-get v 0)", global_frame) ==
+                "1.000000");
+        interpreter::rep("(def tail (f64vec-slice v 1 3))", global_frame);
+        REQUIRE(interpreter::rep("tail", global_frame) ==
+                "#f64(2.500000 3.000000)");
+        REQUIRE(interpreter::rep("(= tail (f64vec 2.5 3))", global_frame) ==
+                "true");
+        REQUIRE(interpreter::rep("(f64vec-get (f64vec-set tail 0 7) 0)",
+                                 global_frame) == "7.000000");
+        REQUIRE(interpreter::rep("(f64vec-get v 1)", global_frame) ==
+                "2.500000");
+        REQUIRE(interpreter::rep("(empty? (f64vec-slice v 1 1))",
+                                 global_frame) == "true");
+        REQUIRE(interpreter::rep("(f64vec? v)", global_frame) == "true");
+}
+
+TEST_CASE("Byte Vectors", "[bytes]")
+{
+        Frame global_frame{Frame::global()};
+        interpreter::rep("(def b (bytes 1 2 3 4 255 0 0 0 0 0 0 240 63))",
+                         global_frame);
+        REQUIRE(interpreter::rep("(count b)", global_frame) == "13");
+        REQUIRE(interpreter::rep("(bytes-ref b 4)", global_frame) == "255");
+        REQUIRE(interpreter::rep("(read-u16-le b 0)", global_frame) == "513");
+        REQUIRE(interpreter::rep("(read-u16-be b 0)", global_frame) == "258");
+        REQUIRE(interpreter::rep("(read-u32-be b 0)", global_frame) ==
+                "16909060");
+        REQUIRE(interpreter::rep("(read-f64-le b 5)", global_frame) ==
+                "1.000000");
+        REQUIRE(interpreter::rep("(read-u64-le (bytes 255 255 255 255 255 "
+                                 "255 255 255) 0)",
+                                 global_frame) == "18446744073709551615");
+        interpreter::rep("(def s (bytes-slice b 2 5))", global_frame);
+        REQUIRE(interpreter::rep("s", global_frame) == "#bytes(03 04 ff)");
+        REQUIRE(interpreter::rep("(read-u16-le s 1)", global_frame) ==
+                "65284");
+        REQUIRE(interpreter::rep("(= s (bytes 3 4 255))", global_frame) ==
+                "true");
+        REQUIRE_THROWS(interpreter::rep("(read-u32-le s 0)", global_frame));
+
+        std::string path = "lispp_bytes_test.bin";
+        std::ofstream{path, std::ios::binary} << "LISP";
+        interpreter::rep("(def f (load-bytes \"" + path + "\"))",
+                         global_frame);
+        REQUIRE(interpreter::rep("(read-u32-be f 0)", global_frame) ==
+                "1279873872");
+        REQUIRE(interpreter::rep("(bytes-slice f 1 3)", global_frame) ==
+                "#bytes(49 53)");
+        std::remove(path.c_str());
+}
+
+TEST_CASE("Inline Argument Storage", "[list]")
+{
+        Frame global_frame{Frame::global()};
+        REQUIRE(interpreter::rep("(+ 1 2 3)", global_frame) == "6");
+        REQUIRE(interpreter::rep("(+ 1 2 3 4 5 6 7 8 9 10 11 12)",
+                                 global_frame) == "78");
+        REQUIRE(interpreter::rep("(list 1 2 3 4 5 6 7 8 9 10 11 12)",
+                                 global_frame) ==
+                "(1 2 3 4 5 6 7 8 9 10 11 12)");
+        interpreter::rep("(def f (fn (a b c d e f g h) (list h g f e d c b a)))",
+                         global_frame);
+        REQUIRE(interpreter::rep("(f 1 2 3 4 5 6 7 8)", global_frame) ==
+                "(8 7 6 5 4 3 2 1)");
+        REQUIRE(interpreter::rep("((fn (x) (* x x)) 7)", global_frame) ==
+                "49");
+        REQUIRE_THROWS(interpreter::rep("(1 2)", global_frame));
+}
+
+TEST_CASE("Memory Footprint", "[memory]")
+{
+        Frame global_frame{Frame::global()};
+        REQUIRE(interpreter::rep("(sizeof-deep 1)", global_frame) == "16");
+        interpreter::rep("(def xs (list \"a\" \"b\" \"c\"))", global_frame);
+        auto single = std::stoul(interpreter::rep("(sizeof-deep xs)",
+                                                  global_frame));
+        auto twice = std::stoul(interpreter::rep("(sizeof-deep (list xs xs))",
+                                                 global_frame));
+        REQUIRE(twice < 2 * single);
+        auto before = std::stoul(interpreter::rep("(frame-memory)",
+                                                  global_frame));
+        interpreter::rep("(def ys xs)", global_frame);
+        interpreter::rep("(def zs (list \"d\" \"e\"))", global_frame);
+        auto after = std::stoul(interpreter::rep("(frame-memory)",
+                                                 global_frame));
+        REQUIRE(after > before);
+        // Bound twice, so dropping one more reference frees nothing.
+        auto xs = global_frame.lookup(symbols::intern("xs"));
+        REQUIRE(footprint::retained_size(xs) == 0);
+        // A fresh list around it retains only its own cells.
+        auto wrapper = type::LisppObject::create_list({xs});
+        auto retained = footprint::retained_size(wrapper);
+        REQUIRE(retained > 0);
+        REQUIRE(retained + single == footprint::deep_size(wrapper));
+}
+
+TEST_CASE("Cycle Collection", "[memory]")
+{
+        Frame global_frame{Frame::global()};
+        interpreter::rep("(gc)", global_frame);
+        auto cells = type::heap_usage.cells;
+        // Each closure is bound in the frame it closes over: a two-cell cycle.
+        interpreter::rep("(let (f (fn (x) x)) 1)", global_frame);
+        interpreter::rep("(let (g (fn (x) x)) 2)", global_frame);
+        REQUIRE(type::heap_usage.cells > cells);
+        REQUIRE(interpreter::rep("(gc)", global_frame) == "4");
+        REQUIRE(type::heap_usage.cells == cells);
+        interpreter::rep("(def t (transient (list)))", global_frame);
+        interpreter::rep("(conj! t t)", global_frame);
+        interpreter::rep("(def t nil)", global_frame);
+        REQUIRE(interpreter::rep("(gc)", global_frame) == "2");
+        // Closures still referenced survive, along with their frames.
+        interpreter::rep("(def h (let (y 5) (fn (x) (+ x y))))",
+                         global_frame);
+        REQUIRE(interpreter::rep("(gc)", global_frame) == "0");
+        REQUIRE(interpreter::rep("(h 1)", global_frame) == "6");
+        REQUIRE(interpreter::rep("(get (gc-stats) \"collections\")",
+                                 global_frame) != "0");
+}
+
+TEST_CASE("Incremental Collection", "[memory]")
+{
+        Frame global_frame{Frame::global()};
+        auto frame = Frame::create(type::Ref<Frame>{&global_frame});
+        interpreter::rep("(def z 10)", *frame);
+        // `h` and the frame it closes over only refer to each other.
+        interpreter::rep("(def h (let (f (fn (x) (+ x z))) f))", *frame);
+        gc::collect();
+        { auto again = frame; }
+        gc::start();
+        REQUIRE_FALSE(gc::step(0));
+        // The frame has been scanned; moving `h` out of it must not leave
+        // `h` counted as referenced only from within the graph.
+        auto h = frame->lookup(symbols::intern("h"));
+        frame->set(symbols::intern("h"), type::LisppObject::create_nil());
+        while (!gc::step(0)) {
+        }
+        REQUIRE(evaluator::apply(h, {type::LisppObject::create_integer(1)})
+                    .integer() == 11);
+        auto slices = gc::stats().slices;
+        interpreter::rep("(let (g (fn (x) x)) 1)", global_frame);
+        gc::start();
+        while (!gc::step(0)) {
+        }
+        REQUIRE(gc::stats().slices > slices + 1);
+        REQUIRE(interpreter::rep("(count (get (gc-stats) \"pause-histogram\"))",
+                                 global_frame) != "0");
+}
+
+TEST_CASE("Cell Pools", "[memory]")
+{
+        using type::LisppObject;
+        auto bytes = type::heap_usage.bytes;
+        const LisppObject* car = nullptr;
+        {
+                auto pair = LisppObject::create_pair(
+                    LisppObject::create_integer(1), LisppObject::create_nil());
+                car = &pair.car();
+                REQUIRE(type::heap_usage.bytes > bytes);
+        }
+        REQUIRE(type::heap_usage.bytes == bytes);
+        // The freed cell is handed out again first.
+        auto pair = LisppObject::create_pair(LisppObject::create_integer(2),
+                                             LisppObject::create_nil());
+        REQUIRE(&pair.car() == car);
+}
+
+TEST_CASE("Reader Arena", "[reader]")
+{
+        Frame global_frame{Frame::global()};
+        // What the reader keeps outlives its scratch.
+        interpreter::rep("(def greeting \"hello, world\")", global_frame);
+        REQUIRE(interpreter::rep("greeting", global_frame) == "hello, world");
+        interpreter::rep("(def some-long-symbol-name 1)", global_frame);
+        REQUIRE(interpreter::rep("some-long-symbol-name", global_frame) == "1");
+        // Each form's scratch is reused by the next.
+        auto capacity = arena::current().capacity();
+        for (int i = 0; i < 100; i++) {
+                interpreter::rep("(list \"a\" \"b\" (+ 1 2) greeting)",
+                                 global_frame);
+        }
+        REQUIRE(arena::current().capacity() == capacity);
+        {
+                arena::Scope scope;
+                auto tokens = Reader::tokenize("(f, \"a, b\" 1)");
+                REQUIRE(tokens.size() == 5);
+                REQUIRE(tokens[2] == "\"a, b\"");
+        }
+}
+
+TEST_CASE("Frame Links", "[frame]")
+{
+        Frame global_frame{Frame::global()};
+        // A call's frame links to the closure's frame rather than copying it,
+        // so the closure sees definitions made after it.
+        interpreter::rep("(def later (fn () later-value))", global_frame);
+        interpreter::rep("(def later-value 7)", global_frame);
+        REQUIRE(interpreter::rep("(later)", global_frame) == "7");
+        interpreter::rep("(def x 1)", global_frame);
+        REQUIRE(interpreter::rep("(let (x 2) x)", global_frame) == "2");
+        REQUIRE(interpreter::rep("x", global_frame) == "1");
+        // Past a handful of bindings a frame is indexed.
+        REQUIRE(interpreter::rep("(let (a 1 b 2 c 3 d 4 e 5 f 6 g 7 h 8 i 9 "
+                                 "j 10 a 11) (+ a j x))",
+                                 global_frame) == "22");
+        interpreter::rep("(def add (fn (a b) (+ a b)))", global_frame);
+        interpreter::rep("(gc)", global_frame);
+        auto cells = type::heap_usage.cells;
+        for (int i = 0; i < 100; i++) {
+                interpreter::rep("(add 1 2)", global_frame);
+        }
+        interpreter::rep("(gc)", global_frame);
+        REQUIRE(type::heap_usage.cells == cells);
+}
+
+TEST_CASE("Heap Quotas", "[memory]")
+{
+        Frame global_frame{Frame::global()};
+        // `bytes` flattens the doubled string into one buffer.
+        interpreter::rep("(def grow (fn (s n) (if (= n 0) (bytes s) "
+                         "(grow (string-append s s) (- n 1)))))",
+                         global_frame);
+        interpreter::Budget budget;
+        budget.heap_bytes = 1 << 20;
+        REQUIRE(interpreter::rep("(bytes-ref (grow \"abcdefgh\" 10) 8191)",
+                                 global_frame, budget) == "104");
+        REQUIRE(budget.peak_heap_bytes >= 8192);
+        REQUIRE(budget.peak_heap_bytes < budget.heap_bytes);
+        // A runaway form fails on its own, and gives back what it held.
+        auto bytes = type::heap_usage.bytes;
+        REQUIRE_THROWS_AS(
+            interpreter::rep("(grow \"abcdefgh\" 20)", global_frame, budget),
+            exception::heap_quota_error);
+        REQUIRE(budget.peak_heap_bytes <= budget.heap_bytes);
+        REQUIRE(type::heap_usage.bytes == bytes);
+        // Quotas nest; an inner one cannot loosen an outer one.
+        size_t outer_peak = 0;
+        {
+                type::HeapQuota outer{4096, outer_peak};
+                interpreter::Budget loose;
+                REQUIRE_THROWS_AS(interpreter::rep("(grow \"abcdefgh\" 10)",
+                                                   global_frame, loose),
+                                  exception::heap_quota_error);
+        }
+        REQUIRE(outer_peak <= 4096);
+        REQUIRE(interpreter::rep("(bytes-ref (grow \"abcdefgh\" 10) 0)",
+                                 global_frame) == "97");
+}
+
+TEST_CASE("Allocation Profile", "[memory]")
+{
+        Frame global_frame{Frame::global()};
+        interpreter::rep("(def pair (fn (n) (list n n)))", global_frame);
+        // Sampling every byte takes every allocation at its own size.
+        interpreter::rep("(alloc-profile 1)", global_frame);
+        for (int i = 0; i < 3; i++) {
+                interpreter::rep("(pair 1)", global_frame);
+        }
+        // Each call allocates its frame, and `list` the list it builds.
+        auto counts = interpreter::rep("(alloc-profile \"count\")",
+                                       global_frame);
+        REQUIRE(counts.find("toplevel;pair 3\n") != std::string::npos);
+        REQUIRE(counts.find("toplevel;pair;list ") != std::string::npos);
+        constexpr size_t granule = type::CellPools::granule;
+        size_t frame_bytes = (sizeof(Frame) + granule - 1) / granule * granule;
+        auto bytes = profiler::report();
+        REQUIRE(bytes.find("toplevel;pair " +
+                           std::to_string(3 * frame_bytes)) !=
+                std::string::npos);
+        interpreter::rep("(alloc-profile 0)", global_frame);
+        REQUIRE_FALSE(profiler::running());
+        REQUIRE(profiler::report().empty());
+        REQUIRE(profiler::calls.empty());
+}
+
+TEST_CASE("Constants", "[reader]")
+{
+        Frame global_frame{Frame::global()};
+        auto form = Reader::read(
+            "(list 100000000000000000000 100000000000000000000)");
+        const auto& items = form.items();
+        REQUIRE(items[1].is_bignum());
+        REQUIRE(items[1].same_cell(items[2]));
+        REQUIRE(interpreter::rep("(!= 1 2)", global_frame) == "true");
+        REQUIRE(interpreter::rep("(!= 1 1.0)", global_frame) == "false");
+        REQUIRE(interpreter::rep("(not (nil? nil))", global_frame) == "false");
+}